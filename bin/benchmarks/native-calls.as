@@ -0,0 +1,35 @@
+/*
+    Per-call overhead of native addon functions: build the addon with
+    "cmake -S native-calls -B native-calls/make && cmake --build native-calls/make --config Release",
+    then run "asx --bench native-calls.as". Each benchmark makes 10000 calls.
+*/
+#include "native-calls/bin/native_calls"
+
+double script_add(double a, double b)
+{
+    return a + b;
+}
+
+[#bench(iterations = 1000, warmup = 100)]
+void script_call()
+{
+    double value = 0.0;
+    for (int32 i = 0; i < 10000; i++)
+        value = script_add(value, 1.0);
+}
+
+[#bench(iterations = 1000, warmup = 100)]
+void native_declared_call()
+{
+    double value = 0.0;
+    for (int32 i = 0; i < 10000; i++)
+        value = native_add_declared(value, 1.0);
+}
+
+[#bench(iterations = 1000, warmup = 100)]
+void native_typed_call()
+{
+    double value = 0.0;
+    for (int32 i = 0; i < 10000; i++)
+        value = native_add_typed(value, 1.0);
+}
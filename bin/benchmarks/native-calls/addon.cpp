@@ -0,0 +1,18 @@
+#include "interface.hpp"
+
+double native_add(double a, double b)
+{
+    return a + b;
+}
+
+extern "C" { INTERFACE_EXPORT int addon_import(); }
+int addon_import()
+{
+    asx_import_interface();
+    asx_export_function("double native_add_declared(double, double)", &native_add);
+    asx_export_typed_function<&native_add>("native_add_typed");
+    return 0;
+}
+
+extern "C" { INTERFACE_EXPORT void addon_cleanup(); }
+void addon_cleanup() { }
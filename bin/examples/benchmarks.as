@@ -0,0 +1,35 @@
+/*
+    Script level benchmarks: run with "asx --bench benchmarks.as",
+    add "--bench-output=results.json" to save results and
+    "--bench-baseline=results.json" to compare with saved results.
+*/
+import from { "string", "dictionary" };
+
+[#bench(iterations = 10000, warmup = 1000)]
+void string_concat()
+{
+    string value;
+    for (int32 i = 0; i < 64; i++)
+        value += to_string(i);
+}
+
+[#bench(iterations = 10000, warmup = 1000)]
+void dictionary_insert()
+{
+    dictionary values;
+    for (int32 i = 0; i < 64; i++)
+        values[to_string(i)] = i;
+}
+
+[#bench(iterations = 1000, warmup = 100)]
+void integer_hash()
+{
+    int32 hash = 0, value = 10000, max = 2 << 29;
+    while (value > 0)
+        hash = ((hash << 5) - hash + value--) % max;
+}
+
+int main()
+{
+    return 0;
+}
\ No newline at end of file
@@ -9,9 +9,10 @@ void print_hello_world()
 extern "C" { INTERFACE_EXPORT int addon_import(); }
 int addon_import()
 {
+    static const asx_function_info functions[] = { asx_function_entry("void print_hello_world()", &print_hello_world) };
+    static const asx_namespace_info namespaces[] = { asx_namespace_entry("", functions) };
     asx_import_interface();
-    asx_export_function("void print_hello_world()", &print_hello_world);
-    return 0;
+    return asx_export(namespaces) ? 0 : -1;
 }
 
 extern "C" { INTERFACE_EXPORT void addon_cleanup(); }
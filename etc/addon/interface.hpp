@@ -13,6 +13,126 @@
 #define INTERFACE_CLOSE(handle) dlclose(handle);
 #define INTERFACE_EXPORT
 #endif
+#include <cstddef>
+#include <type_traits>
+#include <new>
+#include <cstdint>
+#include <string>
+#include <utility>
+#ifndef ASX_INTERFACE_VERSION
+#define ASX_INTERFACE_VERSION 4
+enum asx_member_type
+{
+	asx_member_method = 0,
+	asx_member_operator = 1,
+	asx_member_constructor = 2,
+	asx_member_copy_operator = 3,
+	asx_member_destructor = 4
+};
+
+struct asx_enum_value_info
+{
+	const char* declaration;
+	int value;
+};
+
+struct asx_enum_info
+{
+	const char* name;
+	const asx_enum_value_info* values;
+	size_t values_count;
+};
+
+struct asx_property_info
+{
+	const char* declaration;
+	void* address;
+};
+
+struct asx_function_info
+{
+	const char* declaration;
+	void(*address)();
+};
+
+struct asx_class_property_info
+{
+	const char* declaration;
+	int offset;
+};
+
+struct asx_class_method_info
+{
+	asx_member_type type;
+	const char* declaration;
+	void(*address)();
+};
+
+struct asx_class_info
+{
+	const char* name;
+	size_t size;
+	size_t flags;
+	const asx_class_property_info* properties;
+	size_t properties_count;
+	const asx_class_method_info* methods;
+	size_t methods_count;
+};
+
+struct asx_namespace_info
+{
+	const char* name;
+	const asx_enum_info* enums;
+	size_t enums_count;
+	const asx_class_info* classes;
+	size_t classes_count;
+	const asx_function_info* functions;
+	size_t functions_count;
+	const asx_property_info* properties;
+	size_t properties_count;
+};
+
+struct asx_buffer
+{
+	unsigned char* data;
+	size_t size;
+};
+
+struct asx_promise;
+
+struct asx_interface_table
+{
+	size_t version;
+	void(*import_builtin)(const char* path);
+	void(*import_native)(const char* path);
+	void(*export_property)(const char* declaration, void* property_address);
+	void(*export_function_address)(const char* declaration, void(*function_address)());
+	void(*export_namespace_begin)(const char* name);
+	void(*export_namespace_end)();
+	void(*export_enum)(const char* name);
+	void(*export_enum_value)(const char* name, const char* declaration, int value);
+	void(*export_class_address)(const char* name, size_t size, size_t flags);
+	void(*export_class_property_address)(const char* name, const char* declaration, int property_offset);
+	void(*export_class_constructor_address)(const char* name, const char* declaration, void(*constructor_function_address)(void*));
+	void(*export_class_operator_address)(const char* name, const char* declaration, void(*operator_function_address)());
+	void(*export_class_copy_operator_address)(const char* name, void(*copy_operator_function_address)());
+	void(*export_class_destructor_address)(const char* name, void(*destructor_function_address)(void*));
+	void(*export_class_method_address)(const char* name, const char* declaration, void(*method_function_address)());
+	int(*export_namespaces)(size_t version, const asx_namespace_info* namespaces, size_t namespaces_count);
+	asx_buffer*(*buffer_create)(size_t size);
+	asx_buffer*(*buffer_wrap)(void* data, size_t size, void(*release_callback)(void* data, void* context), void* context);
+	void(*buffer_add_ref)(asx_buffer* buffer);
+	void(*buffer_release)(asx_buffer* buffer);
+	asx_promise*(*promise_create)(const char* type);
+	void(*promise_resolve_void)(asx_promise* target);
+	void(*promise_resolve_integer)(asx_promise* target, int64_t value);
+	void(*promise_resolve_number)(asx_promise* target, double value);
+	void(*promise_resolve_string)(asx_promise* target, const char* data, size_t size);
+	void(*promise_resolve_buffer)(asx_promise* target, asx_buffer* value);
+	void(*promise_reject)(asx_promise* target, const char* message);
+	bool(*execute_async)(void(*callback)(void* context), void* context);
+};
+#endif
 namespace
 {
 	void(*asx_import_builtin)(const char* path) = nullptr;
@@ -30,6 +150,19 @@ namespace
 	void(*asx_export_class_copy_operator_address)(const char* name, void(*copy_operator_function_address)()) = nullptr;
 	void(*asx_export_class_destructor_address)(const char* name, void(*destructor_function_address)(void*)) = nullptr;
 	void(*asx_export_class_method_address)(const char* name, const char* declaration, void(*method_function_address)()) = nullptr;
+	int(*asx_export_namespaces)(size_t version, const asx_namespace_info* namespaces, size_t namespaces_count) = nullptr;
+	asx_buffer*(*asx_buffer_create)(size_t size) = nullptr;
+	asx_buffer*(*asx_buffer_wrap)(void* data, size_t size, void(*release_callback)(void* data, void* context), void* context) = nullptr;
+	void(*asx_buffer_add_ref)(asx_buffer* buffer) = nullptr;
+	void(*asx_buffer_release)(asx_buffer* buffer) = nullptr;
+	asx_promise*(*asx_promise_create)(const char* type) = nullptr;
+	void(*asx_promise_resolve_void)(asx_promise* target) = nullptr;
+	void(*asx_promise_resolve_integer)(asx_promise* target, int64_t value) = nullptr;
+	void(*asx_promise_resolve_number)(asx_promise* target, double value) = nullptr;
+	void(*asx_promise_resolve_string)(asx_promise* target, const char* data, size_t size) = nullptr;
+	void(*asx_promise_resolve_buffer)(asx_promise* target, asx_buffer* value) = nullptr;
+	void(*asx_promise_reject)(asx_promise* target, const char* message) = nullptr;
+	bool(*asx_execute_async)(void(*callback)(void* context), void* context) = nullptr;
 }
 
 template <typename t, typename r, typename... args>
@@ -59,13 +192,65 @@ void asx_export_function(const char* declaration, t function)
 	asx_export_function_address(declaration, function_address);
 }
 template <typename t>
-void asx_export_class(const char* name)
+static const char* asx_typed_declaration()
+{
+	typedef typename std::remove_cv<t>::type type;
+	static_assert(std::is_void<type>::value || std::is_arithmetic<type>::value, "typed functions accept and return only bool, integer and floating point values");
+	if constexpr (std::is_void<type>::value)
+		return "void";
+	else if constexpr (std::is_same<type, bool>::value)
+		return "bool";
+	else if constexpr (std::is_floating_point<type>::value)
+	{
+		static_assert(!std::is_same<type, long double>::value, "long double cannot be passed to scripts");
+		return sizeof(type) == sizeof(float) ? "float" : "double";
+	}
+	else if constexpr (sizeof(type) == 1)
+		return std::is_signed<type>::value ? "int8" : "uint8";
+	else if constexpr (sizeof(type) == 2)
+		return std::is_signed<type>::value ? "int16" : "uint16";
+	else if constexpr (sizeof(type) == 4)
+		return std::is_signed<type>::value ? "int32" : "uint32";
+	else
+		return std::is_signed<type>::value ? "int64" : "uint64";
+}
+template <typename r, typename... args>
+static std::string asx_typed_declaration(const char* name, r(*)(args...))
 {
-	asx_export_class_address(name, sizeof(t),
+	const char* types[] = { asx_typed_declaration<args>()..., nullptr };
+	std::string declaration = asx_typed_declaration<r>();
+	declaration += ' ';
+	declaration += name;
+	declaration += '(';
+	for (size_t i = 0; i < sizeof...(args); i++)
+	{
+		if (i > 0)
+			declaration += ", ";
+		declaration += types[i];
+	}
+	declaration += ')';
+	return declaration;
+}
+template <auto function>
+void asx_export_typed_function(const char* name)
+{
+	/* registered as is, engine calls it through native calling convention without any wrapper in between */
+	std::string declaration = asx_typed_declaration(name, function);
+	asx_export_function(declaration.c_str(), function);
+}
+template <typename t>
+static size_t asx_class_flags()
+{
+	return
 		(std::is_default_constructible<t>::value ? 1 << 0 : 0) |
 		(std::is_destructible<t>::value ? 1 << 1 : 0) |
 		(std::is_copy_assignable<t>::value ? 1 << 2 : 0) |
-		(std::is_copy_constructible<t>::value ? 1 << 4 : 0));
+		(std::is_copy_constructible<t>::value ? 1 << 4 : 0);
+}
+template <typename t>
+void asx_export_class(const char* name)
+{
+	asx_export_class_address(name, sizeof(t), asx_class_flags<t>());
 }
 template <typename t, typename r>
 void asx_export_class_property(const char* name, const char* declaration, r t::* value)
@@ -120,9 +305,155 @@ void asx_export_class_method(const char* name, const char* declaration, r(t::* v
 	void(*method_function_address)() = reinterpret_cast<void(*)()>(value);
 	asx_export_class_method_address(name, declaration, method_function_address);
 }
+template <typename t>
+asx_function_info asx_function_entry(const char* declaration, t function)
+{
+	return { declaration, reinterpret_cast<void(*)()>(size_t(function)) };
+}
+template <typename t>
+asx_property_info asx_property_entry(const char* declaration, t* value)
+{
+	return { declaration, (void*)value };
+}
+inline asx_enum_value_info asx_enum_value_entry(const char* declaration, int value)
+{
+	return { declaration, value };
+}
+template <size_t n>
+asx_enum_info asx_enum_entry(const char* name, const asx_enum_value_info(&values)[n])
+{
+	return { name, values, n };
+}
+template <typename t, typename r>
+asx_class_property_info asx_class_property_entry(const char* declaration, r t::* value)
+{
+	return { declaration, (int)reinterpret_cast<size_t>(&(((t*)0)->*value)) };
+}
+template <typename t, typename r, typename... args>
+asx_class_method_info asx_class_method_entry(const char* declaration, r(t::* value)(args...))
+{
+	return { asx_member_method, declaration, reinterpret_cast<void(*)()>(value) };
+}
+template <typename t, typename r, typename... args>
+asx_class_method_info asx_class_method_entry(const char* declaration, r(t::* value)(args...) const)
+{
+	return { asx_member_method, declaration, reinterpret_cast<void(*)()>(value) };
+}
+template <typename t, typename r, typename... args>
+asx_class_method_info asx_class_operator_entry(const char* declaration, r(t::* value)(args...))
+{
+	return { asx_member_operator, declaration, reinterpret_cast<void(*)()>(value) };
+}
+template <typename t, typename r, typename... args>
+asx_class_method_info asx_class_operator_entry(const char* declaration, r(t::* value)(args...) const)
+{
+	return { asx_member_operator, declaration, reinterpret_cast<void(*)()>(value) };
+}
+template <typename t, typename... args>
+asx_class_method_info asx_class_constructor_entry(const char* declaration = "void f()")
+{
+	return { asx_member_constructor, declaration, reinterpret_cast<void(*)()>(&asx_constructor<t, args...>) };
+}
+template <typename t, typename r, typename... args>
+asx_class_method_info asx_class_copy_operator_entry()
+{
+	return { asx_member_copy_operator, nullptr, reinterpret_cast<void(*)()>(asx_operator<t, r, args...>(&t::operator =)) };
+}
+template <typename t>
+asx_class_method_info asx_class_destructor_entry()
+{
+	return { asx_member_destructor, nullptr, reinterpret_cast<void(*)()>(&asx_destructor<t>) };
+}
+template <typename t>
+asx_class_info asx_class_entry(const char* name)
+{
+	return { name, sizeof(t), asx_class_flags<t>(), nullptr, 0, nullptr, 0 };
+}
+template <typename t, size_t m>
+asx_class_info asx_class_entry(const char* name, const asx_class_method_info(&methods)[m])
+{
+	return { name, sizeof(t), asx_class_flags<t>(), nullptr, 0, methods, m };
+}
+template <typename t, size_t p, size_t m>
+asx_class_info asx_class_entry(const char* name, const asx_class_property_info(&properties)[p], const asx_class_method_info(&methods)[m])
+{
+	return { name, sizeof(t), asx_class_flags<t>(), properties, p, methods, m };
+}
+template <size_t n>
+void asx_namespace_append(asx_namespace_info& target, const asx_enum_info(&values)[n])
+{
+	target.enums = values;
+	target.enums_count = n;
+}
+template <size_t n>
+void asx_namespace_append(asx_namespace_info& target, const asx_class_info(&values)[n])
+{
+	target.classes = values;
+	target.classes_count = n;
+}
+template <size_t n>
+void asx_namespace_append(asx_namespace_info& target, const asx_function_info(&values)[n])
+{
+	target.functions = values;
+	target.functions_count = n;
+}
+template <size_t n>
+void asx_namespace_append(asx_namespace_info& target, const asx_property_info(&values)[n])
+{
+	target.properties = values;
+	target.properties_count = n;
+}
+template <typename... tables>
+asx_namespace_info asx_namespace_entry(const char* name, const tables&... values)
+{
+	asx_namespace_info result = { name, nullptr, 0, nullptr, 0, nullptr, 0, nullptr, 0 };
+	(asx_namespace_append(result, values), ...);
+	return result;
+}
+template <size_t n>
+bool asx_export(const asx_namespace_info(&namespaces)[n])
+{
+	return asx_export_namespaces != nullptr && asx_export_namespaces(ASX_INTERFACE_VERSION, namespaces, n) == 0;
+}
 void asx_import_interface()
 {
     auto handle = INTERFACE_OPEN();
+    auto asx_get_interface = (const asx_interface_table*(*)(size_t))INTERFACE_LOAD(handle, asx_get_interface);
+    auto* table = asx_get_interface ? asx_get_interface(ASX_INTERFACE_VERSION) : nullptr;
+    if (table != nullptr)
+    {
+        asx_import_builtin = table->import_builtin;
+        asx_import_native = table->import_native;
+        asx_export_property = table->export_property;
+        asx_export_function_address = table->export_function_address;
+        asx_export_namespace_begin = table->export_namespace_begin;
+        asx_export_namespace_end = table->export_namespace_end;
+        asx_export_enum = table->export_enum;
+        asx_export_enum_value = table->export_enum_value;
+        asx_export_class_address = table->export_class_address;
+        asx_export_class_property_address = table->export_class_property_address;
+        asx_export_class_constructor_address = table->export_class_constructor_address;
+        asx_export_class_operator_address = table->export_class_operator_address;
+        asx_export_class_copy_operator_address = table->export_class_copy_operator_address;
+        asx_export_class_destructor_address = table->export_class_destructor_address;
+        asx_export_class_method_address = table->export_class_method_address;
+        asx_export_namespaces = table->export_namespaces;
+        asx_buffer_create = table->buffer_create;
+        asx_buffer_wrap = table->buffer_wrap;
+        asx_buffer_add_ref = table->buffer_add_ref;
+        asx_buffer_release = table->buffer_release;
+        asx_promise_create = table->promise_create;
+        asx_promise_resolve_void = table->promise_resolve_void;
+        asx_promise_resolve_integer = table->promise_resolve_integer;
+        asx_promise_resolve_number = table->promise_resolve_number;
+        asx_promise_resolve_string = table->promise_resolve_string;
+        asx_promise_resolve_buffer = table->promise_resolve_buffer;
+        asx_promise_reject = table->promise_reject;
+        asx_execute_async = table->execute_async;
+        INTERFACE_CLOSE(handle);
+        return;
+    }
+
     asx_import_builtin = (decltype(asx_import_builtin))INTERFACE_LOAD(handle, asx_import_builtin);
     asx_import_native = (decltype(asx_import_native))INTERFACE_LOAD(handle, asx_import_native);
     asx_export_property = (decltype(asx_export_property))INTERFACE_LOAD(handle, asx_export_property);
@@ -138,6 +469,19 @@ void asx_import_interface()
     asx_export_class_copy_operator_address = (decltype(asx_export_class_copy_operator_address))INTERFACE_LOAD(handle, asx_export_class_copy_operator_address);
     asx_export_class_destructor_address = (decltype(asx_export_class_destructor_address))INTERFACE_LOAD(handle, asx_export_class_destructor_address);
     asx_export_class_method_address = (decltype(asx_export_class_method_address))INTERFACE_LOAD(handle, asx_export_class_method_address);
+    asx_export_namespaces = (decltype(asx_export_namespaces))INTERFACE_LOAD(handle, asx_export_namespaces);
+    asx_buffer_create = (decltype(asx_buffer_create))INTERFACE_LOAD(handle, asx_buffer_create);
+    asx_buffer_wrap = (decltype(asx_buffer_wrap))INTERFACE_LOAD(handle, asx_buffer_wrap);
+    asx_buffer_add_ref = (decltype(asx_buffer_add_ref))INTERFACE_LOAD(handle, asx_buffer_add_ref);
+    asx_buffer_release = (decltype(asx_buffer_release))INTERFACE_LOAD(handle, asx_buffer_release);
+    asx_promise_create = (decltype(asx_promise_create))INTERFACE_LOAD(handle, asx_promise_create);
+    asx_promise_resolve_void = (decltype(asx_promise_resolve_void))INTERFACE_LOAD(handle, asx_promise_resolve_void);
+    asx_promise_resolve_integer = (decltype(asx_promise_resolve_integer))INTERFACE_LOAD(handle, asx_promise_resolve_integer);
+    asx_promise_resolve_number = (decltype(asx_promise_resolve_number))INTERFACE_LOAD(handle, asx_promise_resolve_number);
+    asx_promise_resolve_string = (decltype(asx_promise_resolve_string))INTERFACE_LOAD(handle, asx_promise_resolve_string);
+    asx_promise_resolve_buffer = (decltype(asx_promise_resolve_buffer))INTERFACE_LOAD(handle, asx_promise_resolve_buffer);
+    asx_promise_reject = (decltype(asx_promise_reject))INTERFACE_LOAD(handle, asx_promise_reject);
+    asx_execute_async = (decltype(asx_execute_async))INTERFACE_LOAD(handle, asx_execute_async);
 	INTERFACE_CLOSE(handle);
 }
 #endif
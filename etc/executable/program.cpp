@@ -1,13 +1,23 @@
-#include "program.hpp"
 #include "runtime.hpp"
 #include <vengeance/vengeance.h>
 #include <vengeance/bindings.h>
 #include <vengeance/layer.h>
 #include <signal.h>
+#ifdef _MSC_VER
+#include <windows.h>
+#elif defined(HAS_PROGRAM_BYTECODE)
+extern "C" const uint8_t program_bytecode_data[];
+extern "C" const uint8_t program_bytecode_end[];
+#endif
 
 using namespace vitex::layer;
 using namespace asx;
 
+#ifdef HAS_PROGRAM_AOT
+extern const aot_function program_aot_functions[];
+extern const size_t program_aot_functions_count;
+aot_compiler native_code(program_aot_functions, program_aot_functions_count);
+#endif
 event_loop* loop = nullptr;
 virtual_machine* vm = nullptr;
 compiler* unit = nullptr;
@@ -20,6 +30,7 @@ void exit_program(int sigv)
 	if (sigv != SIGINT && sigv != SIGTERM)
 		return;
 
+	native_completions::get().stop();
 	umutex<std::mutex> unique(mutex);
 	{
 		if (runtime::try_context_exit(environment_config::get(), sigv))
@@ -58,14 +69,19 @@ void setup_program(environment_config& env)
 	signal(SIGCHLD, SIG_IGN);
 #endif
 }
-bool load_program(environment_config& env)
+bool load_program(byte_code_info& info)
 {
-#ifdef HAS_PROGRAM_BYTECODE
-	program_bytecode::foreach(&env, [](void* context, const char* buffer, unsigned size)
-	{
-		environment_config* env = (environment_config*)context;
-		env->program = codec::base64_decode(std::string_view(buffer, (size_t)size));
-	});
+#if defined(HAS_PROGRAM_BYTECODE) && defined(_MSC_VER)
+	HRSRC resource = FindResource(nullptr, TEXT("PROGRAM_BYTECODE"), RT_RCDATA);
+	HGLOBAL handle = resource ? LoadResource(nullptr, resource) : nullptr;
+	const uint8_t* buffer = handle ? (const uint8_t*)LockResource(handle) : nullptr;
+	if (!buffer)
+		return false;
+
+	info.data.insert(info.data.begin(), buffer, buffer + SizeofResource(nullptr, resource));
+	return true;
+#elif defined(HAS_PROGRAM_BYTECODE)
+	info.data.insert(info.data.begin(), program_bytecode_data, program_bytecode_end);
 	return true;
 #else
 	return false;
@@ -73,15 +89,30 @@ bool load_program(environment_config& env)
 }
 int main(int argc, char* argv[])
 {
+	const char* workers = std::getenv("ASX_WORKERS");
+	if (workers != nullptr && runtime::spawn_workers(from_string<uint32_t>(workers).or_else(0), exit_code))
+		return exit_code;
+
 	environment_config env;
+	env.profiler.start(std::getenv("ASX_PROFILE_STARTUP"));
 	env.path = *os::directory::get_module();
 	env.library = argc > 0 ? argv[0] : "runtime";
 	env.auto_schedule = {{BUILDER_ENV_AUTO_SCHEDULE}};
 	env.auto_console = {{BUILDER_ENV_AUTO_CONSOLE}};
 	env.auto_stop = {{BUILDER_ENV_AUTO_STOP}};
-	if (!load_program(env))
+	env.gc.pause = {{BUILDER_ENV_GC_PAUSE}};
+	env.gc.growth = {{BUILDER_ENV_GC_GROWTH}};
+	env.gc.interval = {{BUILDER_ENV_GC_INTERVAL}};
+	env.gc.adaptive = {{BUILDER_ENV_GC_ADAPTIVE}};
+	env.gc_stats.report = std::getenv("ASX_GC_STATS") != nullptr;
+	env.profile = std::getenv("ASX_PROFILE") ? std::getenv("ASX_PROFILE") : "";
+	env.profile_frequency = std::getenv("ASX_PROFILE_FREQUENCY") ? from_string<uint32_t>(std::getenv("ASX_PROFILE_FREQUENCY")).or_else(99) : 99;
+
+	byte_code_info info;
+	if (!load_program(info))
 		return 0;
 
+	env.profiler.record("load_program");
 	vector<string> args;
 	args.reserve((size_t)argc);
 	for (int i = 0; i < argc; i++)
@@ -99,26 +130,32 @@ int main(int argc, char* argv[])
 	config.full_stack_tracing = {{BUILDER_CONFIG_FULL_STACK_TRACING}};
 	setup_program(env);
 
-	size_t modules = vitex::use_networking | vitex::use_cryptography | vitex::use_providers | vitex::use_locale;
+	size_t modules = {{BUILDER_CONFIG_MODULES}};
 	if (!config.essentials_only)
 		modules |= vitex::use_platform | vitex::use_audio | vitex::use_graphics;
 
 	vitex::heavy_runtime scope(modules);
 	{
+		env.profiler.record("runtime");
 		vm = new virtual_machine();
 		bindings::heavy_registry().bind_addons(vm);
+		env.profiler.record("bind_addons");
 		unit = vm->create_compiler();
 		context = vm->request_context();
 
 		vector<std::pair<uint32_t, size_t>> settings = { {{BUILDER_CONFIG_SETTINGS}} };
 		for (auto& item : settings)
 			vm->set_property((features)item.first, item.second);
+#ifdef HAS_PROGRAM_AOT
+		vm->get_engine()->SetJITCompiler(&native_code);
+#endif
 
 		unit = vm->create_compiler();
 		exit_code = runtime::configure_context(config, env, vm, unit) ? (int)exit_status::OK : (int)exit_status::compiler_error;
 		if (exit_code != (int)exit_status::OK)
 			goto finish_program;
 
+		env.profiler.record("configure_context");
 		runtime::configure_system(config);
 		if (!unit->prepare(env.library))
 		{
@@ -127,8 +164,7 @@ int main(int argc, char* argv[])
 			goto finish_program;
 		}
 
-		byte_code_info info;
-		info.data.insert(info.data.begin(), env.program.begin(), env.program.end());
+		env.profiler.record("prepare");
 		if (!unit->load_byte_code(&info).get())
 		{
 			VI_ERR("cannot load <%s> module bytecode", env.library);
@@ -136,6 +172,7 @@ int main(int argc, char* argv[])
 			goto finish_program;
 		}
 
+		env.profiler.record("load_byte_code");
 		program_entrypoint entrypoint;
 		function main = runtime::get_entrypoint(env, entrypoint, unit);
 		if (!main.is_valid())
@@ -10,11 +10,15 @@ namespace asx
 		add_default_settings();
 		listen_for_signals();
 		env.parse(args_count, args, flags);
+		env.profiler.start(env.commandline.has("profile-startup") ? "1" : std::getenv("ASX_PROFILE_STARTUP"));
 		error_handling::set_flag(log_option::report_sys_errors, false);
 		error_handling::set_flag(log_option::active, true);
 		error_handling::set_flag(log_option::pretty, false);
 		config.essentials_only = !env.commandline.has("engine", "e");
 		config.install = env.commandline.has("install", "i") || env.commandline.has("target");
+		auto workers = env.commandline.args.find("workers");
+		if (workers != env.commandline.args.end())
+			config.workers = from_string<uint32_t>(workers->second).or_else(0);
 #ifndef NDEBUG
 		os::directory::set_working(os::directory::get_module()->c_str());
 		config.save_source_code = true;
@@ -37,7 +41,6 @@ namespace asx
 		terminal->attach();
 
 		vm = new virtual_machine();
-		bindings::heavy_registry().bind_addons(vm);
 		for (auto& next : env.commandline.args)
 		{
 			if (next.first == "__path__")
@@ -82,12 +85,14 @@ namespace asx
 			}
 
 			env.library = os::path::get_filename(env.path).data();
-			env.program = *os::file::read_as_string(env.path);
+			if (!config.load_byte_code)
+				env.program = *os::file::read_as_string(env.path);
 			env.registry += "addons";
 			env.registry += VI_SPLITTER;
 		}
 
-		if (!config.interactive && env.addon.empty() && env.program.empty())
+		bool has_program = config.load_byte_code ? env.file.size > 0 : !env.program.empty();
+		if (!config.interactive && env.addon.empty() && !has_program)
 		{
 			config.interactive = true;
 			if (env.commandline.args.size() > 1)
@@ -105,10 +110,32 @@ namespace asx
 			return (int)exit_status::ok;
 		}
 
+		if (config.debug || config.interactive || config.install || config.dependencies || config.bench || env.registry.empty())
+			config.cache = false;
+
+		bool locked = config.install && !env.registry.empty() && builder::load_addon_lock(env);
+		if (config.dependencies && !config.install && !config.load_byte_code && has_program && !env.registry.empty())
+		{
+			uptr<schema> graph = code_cache::get_graph(env.registry, env.path);
+			if (graph)
+			{
+				print_dependencies(*graph);
+				return (int)exit_status::ok;
+			}
+		}
+
+		env.profiler.record("arguments");
+
+		/* registers import callbacks only, each addon is bound on its first import */
+		bindings::heavy_registry().bind_addons(vm);
+		env.profiler.record("bind_addons");
+
 		unit = vm->create_compiler();
 		if (!runtime::configure_context(config, env, vm, unit))
 			return (int)exit_status::compiler_error;
 
+		env.profiler.record("configure_context");
+
 		os::directory::set_working(os::path::get_directory(env.path.c_str()).c_str());
 		if (config.debug)
 		{
@@ -136,30 +163,64 @@ namespace asx
 			return (int)exit_status::prepare_error;
 		}
 
+		env.profiler.record("prepare");
 		context = vm->request_context();
-		if (!env.program.empty())
+		if (has_program)
 		{
 			if (!config.load_byte_code)
 			{
-				status = unit->load_code(env.path, env.program);
-				if (!status)
+				if (config.cache && code_cache::load(config, env, vm, unit, settings))
 				{
-					VI_ERR("%s load error: %s", env.library, status.error().what());
-					return (int)exit_status::loading_error;
+					VI_DEBUG("%s loaded from cache", env.library);
+					env.profiler.record("load_byte_code");
 				}
-
-				runtime::configure_system(config);
-				status = unit->compile().get();
-				if (!status)
+				else
 				{
-					VI_ERR("%s compile error: %s", env.library, status.error().what());
-					return (int)exit_status::compiler_error;
+					auto* module = config.cache ? unit->get_module().get_module() : nullptr;
+					if (module != nullptr)
+					{
+						/* failed cache load may leave partially loaded bytecode behind, start from an empty module */
+						module->Discard();
+						status = unit->prepare(env.library);
+						if (!status)
+						{
+							VI_ERR("%s> prepare error: %s", env.library, status.error().what());
+							return (int)exit_status::prepare_error;
+						}
+					}
+
+					status = unit->load_code(env.path, env.program);
+					if (!status)
+					{
+						VI_ERR("%s load error: %s", env.library, status.error().what());
+						return (int)exit_status::loading_error;
+					}
+
+					env.profiler.record("load_code");
+					if (builder::compile_into_addons(config, env, vm) != status_code::OK)
+						return (int)exit_status::command_error;
+
+					runtime::configure_system(config);
+					status = unit->compile().get();
+					if (!status)
+					{
+						VI_ERR("%s compile error: %s", env.library, status.error().what());
+						return (int)exit_status::compiler_error;
+					}
+
+					env.profiler.record("compile");
+					if (config.cache)
+						code_cache::store(config, env, vm, unit, settings);
 				}
 			}
 			else
 			{
 				byte_code_info info;
-				info.data.insert(info.data.begin(), env.program.begin(), env.program.end());
+				if (!builder::read_byte_code(env.path, &info))
+				{
+					VI_ERR("%s load error: cannot read bytecode file", env.library);
+					return (int)exit_status::loading_error;
+				}
 
 				runtime::configure_system(config);
 				status = unit->load_byte_code(&info).get();
@@ -168,18 +229,35 @@ namespace asx
 					VI_ERR("%s load: %s", env.library, status.error().what());
 					return (int)exit_status::loading_error;
 				}
+
+				env.profiler.record("load_byte_code");
 			}
 		}
 
-		if (config.install)
+		for (auto& item : config.gc_settings)
+			env.gc.configure(item.first, item.second);
+
+		if (config.bench && has_program)
+		{
+			vm->set_exception_callback(&runtime::context_thrown);
+			return benchmark::execute(env, vm, context, unit) ? (int)exit_status::ok : (int)exit_status::runtime_error;
+		}
+		else if (config.install)
 		{
 			if (config.installed > 0)
 			{
+				builder::store_addon_lock(env, vm);
 				terminal->write_line("Successfully installed " + to_string(config.installed) + string(config.installed > 1 ? " addons" : " addon"));
 				return EXIT_SUCCESS;
 			}
 			else if (env.output.empty())
-				return builder::pull_addon_repository(config, env) == status_code::OK ? (int)exit_status::ok : (int)exit_status::command_error;
+			{
+				if (!locked && (builder::pull_addon_repository(config, env) != status_code::OK || builder::compile_into_addons(config, env, vm) != status_code::OK))
+					return (int)exit_status::command_error;
+
+				builder::store_addon_lock(env, vm);
+				return (int)exit_status::ok;
+			}
 
 			if (builder::compile_into_executable(config, env, vm, builder::get_default_settings()) != status_code::OK)
 				return (int)exit_status::command_error;
@@ -199,7 +277,9 @@ namespace asx
 		}
 		else if (config.dependencies)
 		{
-			print_dependencies();
+			if (has_program && !env.registry.empty())
+				code_cache::store_graph(env, vm);
+			print_dependencies(nullptr);
 			return (int)exit_status::ok;
 		}
 		else if (config.interactive)
@@ -226,6 +306,7 @@ namespace asx
 			bindings::heavy_registry().bind_stringifiers(debugger);
 
 			char default_code[] = "void main(){}";
+			vector<std::pair<string, string>> registered;
 			bool editor = false;
 			size_t section = 0;
 			env.path += env.library;
@@ -297,6 +378,8 @@ namespace asx
 					terminal->write_line("  .editor - enter editor mode");
 					terminal->write_line("  .exit   - exit interactive mode");
 					terminal->write_line("  .use    - import system addons by name (comma separated list)");
+					terminal->write_line("  .time   - execute an expression once and report time, gc objects and retained heap bytes");
+					terminal->write_line("  .bench  - execute an expression repeatedly and report time, gc objects and retained heap bytes per run");
 					terminal->write_line("  *       - anything else will be interpreted as script code");
 					continue;
 				}
@@ -325,6 +408,16 @@ namespace asx
 						terminal->write_line("  register mode: you may now register script interfaces");
 					continue;
 				}
+				else if (stringify::starts_with(data, ".time"))
+				{
+					benchmark::execute_expression(vm, context, unit, data.substr(5), false);
+					continue;
+				}
+				else if (stringify::starts_with(data, ".bench"))
+				{
+					benchmark::execute_expression(vm, context, unit, data.substr(6), true);
+					continue;
+				}
 				else if (stringify::starts_with(data, ".editor"))
 				{
 					terminal->write_line("  editor mode: you may write multiple lines of code (ctrl+d to finish)\n");
@@ -340,8 +433,18 @@ namespace asx
 
 				if (!env.inlined)
 				{
-					string index = ":" + to_string(++section);
-					if (!unit->load_code(env.path + index, data) || unit->compile().get())
+					string index = env.path + ":" + to_string(++section);
+					if (register_code(index, data))
+					{
+						registered.push_back(std::make_pair(std::move(index), data));
+						continue;
+					}
+
+					bool loaded = true;
+					for (auto& item : registered)
+						loaded = loaded && unit->load_code(item.first, item.second);
+					registered.clear();
+					if (!loaded || !unit->load_code(index, data) || unit->compile().get())
 						continue;
 				}
 
@@ -401,6 +504,7 @@ namespace asx
 	}
 	void environment::shutdown(int value)
 	{
+		native_completions::get().stop();
 		umutex<std::mutex> unique(mutex);
 		{
 			if (runtime::try_context_exit(env, value))
@@ -444,6 +548,17 @@ namespace asx
 	{
 		VI_PANIC(false, "%s (critical runtime error)", signal);
 	}
+	bool environment::supervise(int& exit_code)
+	{
+		if (config.workers < 2 || config.install || env.commandline.params.empty() || env.commandline.has("interactive") || env.commandline.has("debug"))
+			return false;
+
+		if (runtime::spawn_workers(config.workers, exit_code))
+			return true;
+
+		listen_for_signals();
+		return false;
+	}
 	size_t environment::get_init_flags()
 	{
 		size_t library_layer = vitex::use_networking | vitex::use_cryptography | vitex::use_locale;
@@ -452,10 +567,29 @@ namespace asx
 		if (config.install)
 			return library_layer;
 
-		if (config.essentials_only)
+		if (!config.essentials_only)
+			return game_layer;
+
+		if (env.commandline.params.empty() || env.commandline.has("load-bytecode") || env.commandline.has("import-addon") || env.commandline.has("import-library") || env.commandline.has("import-function"))
+			return application_layer;
+
+		size_t import_layer = 0;
+		auto imports = env.commandline.args.find("import");
+		if (imports != env.commandline.args.end())
+			import_layer = builder::get_init_modules(stringify::split(imports->second, '+'), false);
+
+		file_entry state;
+		string directory = *os::directory::get_working();
+		auto file = os::path::resolve(env.commandline.params.front(), directory, true);
+		if (!file || !os::file::get_state(*file, &state) || state.is_directory)
+			file = os::path::resolve(env.commandline.params.front() + ".as", directory, true);
+		if (!file)
 			return application_layer;
 
-		return game_layer;
+		string registry = os::path::get_directory(*file);
+		registry += "addons";
+		registry += VI_SPLITTER;
+		return code_cache::get_init_modules(registry, *file, application_layer) | import_layer;
 	}
 	void environment::add_default_commands()
 	{
@@ -489,6 +623,64 @@ namespace asx
 			config.save_byte_code = true;
 			return (int)exit_status::next;
 		});
+		add_command("execution", "--profile-startup", "print startup phases timing as json when main is entered (ASX_PROFILE_STARTUP=path writes it to a file)", true, [](const std::string_view&)
+		{
+			return (int)exit_status::next;
+		});
+		add_command("execution", "--profile", "sample script call stacks and write folded stacks on exit or SIGUSR2 [expects: path]", false, [this](const std::string_view& path)
+		{
+			env.profile = path;
+			return (int)exit_status::next;
+		});
+		add_command("execution", "--profile-frequency", "set sampling profiler frequency, default is 99 [expects: hertz]", false, [this](const std::string_view& value)
+		{
+			auto frequency = from_string<uint32_t>(value);
+			if (!frequency || !*frequency)
+			{
+				VI_ERR("%s profile error: invalid frequency", value.data());
+				return (int)exit_status::input_error;
+			}
+
+			env.profile_frequency = *frequency;
+			return (int)exit_status::next;
+		});
+		add_command("execution", "--bench", "run functions tagged with #[bench(iterations, warmup)] instead of main and print timings", true, [this](const std::string_view&)
+		{
+			config.bench = true;
+			return (int)exit_status::next;
+		});
+		add_command("execution", "--bench-output", "write benchmark results as json [expects: path]", false, [this](const std::string_view& path)
+		{
+			env.bench_output = path;
+			return (int)exit_status::next;
+		});
+		add_command("execution", "--bench-baseline", "compare benchmark medians with previously written json results [expects: path]", false, [this](const std::string_view& path)
+		{
+			env.bench_baseline = path;
+			return (int)exit_status::next;
+		});
+		add_command("execution", "--gc-stats", "print garbage collector statistics summary on exit (ASX_GC_STATS=1 for built executables)", true, [this](const std::string_view&)
+		{
+			env.gc_stats.report = true;
+			return (int)exit_status::next;
+		});
+		add_command("execution", "--no-cache", "disable compiled bytecode cache (stored in addons directory near script file)", true, [this](const std::string_view&)
+		{
+			config.cache = false;
+			return (int)exit_status::next;
+		});
+		add_command("execution", "--workers", "run script in n processes sharing listening sockets, restart crashed ones [expects: count]", false, [this](const std::string_view& value)
+		{
+			auto count = from_string<uint32_t>(value);
+			if (!count)
+			{
+				VI_ERR("%s workers error: invalid count", value.data());
+				return (int)exit_status::input_error;
+			}
+
+			config.workers = *count;
+			return (int)exit_status::next;
+		});
 		add_command("execution", "-fast-stack-tracing", "disable full stack tracing", true, [this](const std::string_view&)
 		{
 			config.full_stack_tracing = false;
@@ -587,6 +779,29 @@ namespace asx
 			VI_ERR("%s must be a directory", path.data());
 			return (int)exit_status::input_error;
 		});
+		add_command("building", "--lto", "build executable with link-time optimization", true, [this](const std::string_view&)
+		{
+			config.lto = true;
+			return (int)exit_status::next;
+		});
+		add_command("building", "--aot", "build executable with script functions translated ahead-of-time into native code where possible", true, [this](const std::string_view&)
+		{
+			config.aot = true;
+			vm->set_property(features::include_jit_instructions, 1);
+			vm->set_property(features::jit_interface_version, 1);
+			return (int)exit_status::next;
+		});
+		add_command("building", "--pgo", "build executable twice with profile-guided optimization, profile is collected by running built executable", true, [this](const std::string_view&)
+		{
+			config.pgo = true;
+			return (int)exit_status::next;
+		});
+		add_command("building", "--pgo-training", "run custom command to collect pgo profile instead of built executable [expects: command]", false, [this](const std::string_view& value)
+		{
+			config.pgo = true;
+			env.pgo_training = value;
+			return (int)exit_status::next;
+		});
 		add_command("building", "--import", "import standard addon(s) by name [expects: plus(+) separated list]", false, [this](const std::string_view& value)
 		{
 			for (auto& item : stringify::split(value, '+'))
@@ -653,7 +868,22 @@ namespace asx
 				return (int)exit_status::input_error;
 			}
 
-			auto it = settings.find(stringify::trim(args[0]));
+			string& name = stringify::trim(args[0]);
+			if (stringify::starts_with(name, "gc_"))
+			{
+				string data = stringify::trim(args[1]);
+				stringify::to_lower(data);
+				if (!gc_policy().configure(name.substr(3), data))
+				{
+					VI_ERR("%s property error: invalid gc policy value", name.c_str());
+					return (int)exit_status::input_error;
+				}
+
+				config.gc_settings.emplace_back(name.substr(3), data);
+				return (int)exit_status::next;
+			}
+
+			auto it = settings.find(name);
 			if (it == settings.end())
 			{
 				VI_ERR("%s property error: invalid property name", args[0].c_str());
@@ -752,6 +982,30 @@ namespace asx
 			config.install = true;
 			return (int)exit_status::next;
 		});
+		add_command("addons", "-j, --jobs", "set max number of parallel build jobs during install, default is 1 [expects: count]", false, [this](const std::string_view& value)
+		{
+			auto count = from_string<uint32_t>(value);
+			if (!count || !*count)
+			{
+				VI_ERR("%s jobs error: invalid count", value.data());
+				return (int)exit_status::input_error;
+			}
+
+			config.jobs = *count;
+			return (int)exit_status::next;
+		});
+		add_command("addons", "--mirror", "install addons from local mirror of repositories instead of github, same as ASX_ADDONS_MIRROR [expects: path]", false, [this](const std::string_view& value)
+		{
+			auto directory = os::path::resolve(value, *os::directory::get_working(), true);
+			if (!directory)
+			{
+				VI_ERR("%s mirror error: invalid path", value.data());
+				return (int)exit_status::input_error;
+			}
+
+			env.mirror = *directory;
+			return (int)exit_status::next;
+		});
 		add_command("addons", "--addons", "install and show dependencies message", true, [this](const std::string_view&)
 		{
 			config.dependencies = true;
@@ -856,6 +1110,11 @@ namespace asx
 	}
 	expects_preprocessor<include_type> environment::import_addon(preprocessor* base, const include_result& file, string& output)
 	{
+		if (file.is_remote)
+			config.cache = false;
+		else if (file.is_file && !file.module.empty())
+			env.includes.insert(file.module);
+
 		if (file.library.empty() || file.library.front() != '@')
 			return include_type::unchanged;
 
@@ -865,15 +1124,18 @@ namespace asx
 			return include_type::error;
 		}
 
+		if (config.install && builder::is_addon_modified(env, vm, file.library))
+			return include_type::error;
+
 		include_type status;
-		if (!builder::is_addon_target_exists(env, vm, file.library))
+		if (!builder::is_addon_target_exists(env, vm, file.library) || (config.install && !builder::is_addon_locked(env, vm, file.library)))
 		{
 			if (!config.install)
 			{
 				VI_ERR("%s required: use --install", file.library.c_str());
 				status = include_type::error;
 			}
-			else if (builder::compile_into_addon(config, env, vm, file.library, output) == status_code::OK)
+			else if (builder::fetch_into_addon(config, env, file.library, output) == status_code::OK)
 			{
 				status = output.empty() ? include_type::computed : include_type::preprocess;
 				++config.installed;
@@ -973,11 +1235,41 @@ namespace asx
 				terminal->write(to_string(value));
 			terminal->write("\n");
 		}
+
+		terminal->write("  gc_adaptive: " + string(env.gc.adaptive ? "ON" : "OFF") + "\n");
+		terminal->write("  gc_pause: " + to_string(env.gc.pause) + "us\n");
+		terminal->write("  gc_growth: " + to_string(env.gc.growth) + " objects\n");
+		terminal->write("  gc_interval: " + to_string(env.gc.interval) + "ms\n");
 	}
-	void environment::print_dependencies()
+	void environment::print_dependencies(schema* graph)
 	{
+		vector<string> exposes;
+		vector<std::pair<string, string>> remotes;
+		if (graph != nullptr)
+		{
+			schema* graph_exposes = graph->get("exposes");
+			if (graph_exposes != nullptr)
+			{
+				for (auto* item : graph_exposes->get_childs())
+					exposes.push_back(item->value.get_blob());
+			}
+
+			schema* graph_addons = graph->get("addons");
+			if (graph_addons != nullptr)
+			{
+				for (auto* item : graph_addons->get_childs())
+					remotes.push_back(std::make_pair(item->get_var("name").get_blob(), item->get_var("library").get_blob()));
+			}
+		}
+		else
+		{
+			for (auto& item : vm->get_exposed_addons())
+				exposes.push_back(item);
+			for (auto& item : env.addons)
+				remotes.push_back(std::make_pair(item, builder::get_addon_target_library(env, vm, item, nullptr)));
+		}
+
 		auto* terminal = console::get();
-		auto exposes = vm->get_exposed_addons();
 		if (!exposes.empty())
 		{
 			terminal->write_line("  local dependencies list:");
@@ -985,12 +1277,50 @@ namespace asx
 				terminal->write_line("    " + stringify::replace(item, ":", ": "));
 		}
 
-		if (!env.addons.empty())
+		if (!remotes.empty())
 		{
 			terminal->write_line("  remote dependencies list:");
-			for (auto& item : env.addons)
-				terminal->write_line("    " + item + ": " + builder::get_addon_target_library(env, vm, item, nullptr));
+			for (auto& item : remotes)
+				terminal->write_line("    " + item.first + ": " + item.second);
+		}
+	}
+	bool environment::register_code(const std::string_view& section, const std::string_view& code)
+	{
+		/* directives change preprocessor state (includes, pragmas, definitions), those are left to full rebuild */
+		if (code.find('#') != std::string::npos)
+			return false;
+
+		string name = string(section), source = string(code);
+		if (!unit->get_processor()->process(name, source))
+			return false;
+
+		stringify::trim(source);
+		size_t body = source.find('{');
+		if (body != std::string::npos)
+		{
+			size_t depth = 0;
+			for (size_t i = body; i < source.size(); i++)
+			{
+				if (source[i] == '{')
+					++depth;
+				else if (source[i] == '}' && depth > 0 && --depth == 0 && i + 1 != source.size())
+					return false;
+			}
+
+			size_t args = source.find('(');
+			if (depth > 0 || source.back() != '}' || args == std::string::npos || args > body)
+				return false;
 		}
+		else if (source.empty() || source.back() != ';')
+			return false;
+
+		auto* module = unit->get_module().get_module();
+		if (!module)
+			return false;
+
+		/* anything that does not compile as a single function or global variable is handled by full rebuild */
+		int result = body != std::string::npos ? module->CompileFunction(name.c_str(), source.c_str(), 0, asCOMP_ADD_TO_MODULE, nullptr) : module->CompileGlobalVar(name.c_str(), source.c_str(), 0);
+		return result >= 0;
 	}
 	void environment::listen_for_signals()
 	{
@@ -1006,11 +1336,18 @@ namespace asx
 #endif
 	}
 }
-
 int main(int argc, char* argv[])
 {
 	auto* instance = new asx::environment(argc, argv);
+	int supervisor_code = 0;
+	if (instance->supervise(supervisor_code))
+	{
+		delete instance;
+		return supervisor_code;
+	}
+
 	vitex::heavy_runtime scope(instance->get_init_flags());
+	instance->env.profiler.record("runtime");
 	int exit_code = instance->dispatch();
 	delete instance;
 	return exit_code;
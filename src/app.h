@@ -40,6 +40,7 @@ namespace asx
 		void shutdown(int value);
 		void interrupt(int value);
 		void abort(const char* signal);
+		bool supervise(int& exit_code);
 		size_t get_init_flags();
 
 	private:
@@ -51,7 +52,8 @@ namespace asx
 		void print_introduction(const char* label);
 		void print_help();
 		void print_properties();
-		void print_dependencies();
+		void print_dependencies(schema* graph);
+		bool register_code(const std::string_view& section, const std::string_view& code);
 		void listen_for_signals();
 		expects_preprocessor<include_type> import_addon(preprocessor* base, const include_result& file, string& output);
 	};
@@ -0,0 +1,470 @@
+#include <vengeance/vengeance.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#ifdef VI_UNIX
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+using namespace vitex::core;
+
+namespace asx
+{
+	struct benchmark_options
+	{
+		string executable;
+		string suite;
+		string examples;
+		string baseline;
+		string output;
+		string workspace;
+		unordered_set<string> modes = { "source", "bytecode", "executable", "aot" };
+		double threshold = 0.1;
+		size_t repeat = 3;
+		bool update_baseline = false;
+	};
+
+	struct benchmark_http
+	{
+		string path = "/";
+		uint16_t port = 8080;
+		size_t connections = 16;
+		size_t requests = 100000;
+	};
+
+	struct benchmark_measurement
+	{
+		double wall_ms = 0.0;
+		double startup_ms = 0.0;
+		double requests_per_second = 0.0;
+		int64_t peak_rss_kb = 0;
+		int exit_code = -1;
+	};
+
+	class benchmark_suite
+	{
+	public:
+		static int execute(benchmark_options& options)
+		{
+			auto suite_data = os::file::read_as_string(options.suite);
+			if (!suite_data)
+			{
+				VI_ERR("%s suite error: not found", options.suite.c_str());
+				return 1;
+			}
+
+			auto suite_result = schema::from_json(*suite_data);
+			if (!suite_result)
+			{
+				VI_ERR("%s suite error: invalid json", options.suite.c_str());
+				return 1;
+			}
+
+			uptr<schema> suite = *suite_result;
+			if (suite->has("threshold"))
+				options.threshold = suite->get_var("threshold").get_number();
+			if (suite->has("repeat"))
+				options.repeat = (size_t)std::max<int64_t>(1, suite->get_var("repeat").get_integer());
+
+			uptr<schema> baseline;
+			auto baseline_data = os::file::read_as_string(options.baseline);
+			if (baseline_data && !options.update_baseline)
+			{
+				auto baseline_result = schema::from_json(*baseline_data);
+				if (baseline_result)
+					baseline = *baseline_result;
+			}
+
+			if (!options.update_baseline)
+			{
+				/* nothing to gate against yet, results are still reported and only failed runs count */
+				schema* baseline_results = baseline ? baseline->get("results") : nullptr;
+				if (!baseline_results || baseline_results->get_childs().empty())
+				{
+					VI_WARN("%s baseline warning: missing or empty, comparison skipped (record it with --update-baseline on reference machine)", options.baseline.c_str());
+					baseline.reset();
+				}
+			}
+
+			uptr<schema> report = var::set::object();
+			report->set("executable", var::string(options.executable));
+			report->set("repeat", var::integer((int64_t)options.repeat));
+			schema* results = report->set("results", var::set::array());
+			schema* cases = suite->get("cases");
+			size_t regressions = 0;
+			for (auto* item : cases ? cases->get_childs() : vector<schema*>())
+			{
+				string name = item->get_var("name").get_blob();
+				string script = options.examples + item->get_var("script").get_blob();
+				vector<string> args;
+				schema* args_data = item->get("args");
+				for (auto* arg : args_data ? args_data->get_childs() : vector<schema*>())
+				{
+					string value = arg->value.get_blob();
+					stringify::replace(value, "${examples}", options.examples);
+					args.push_back(std::move(value));
+				}
+
+				benchmark_http http;
+				schema* http_data = item->get("http");
+				if (http_data != nullptr)
+				{
+					http.path = http_data->has("path") ? http_data->get_var("path").get_blob() : http.path;
+					http.port = http_data->has("port") ? (uint16_t)http_data->get_var("port").get_integer() : http.port;
+					http.connections = http_data->has("connections") ? (size_t)http_data->get_var("connections").get_integer() : http.connections;
+					http.requests = http_data->has("requests") ? (size_t)http_data->get_var("requests").get_integer() : http.requests;
+				}
+
+				schema* modes = item->get("modes");
+				for (auto* mode_data : modes ? modes->get_childs() : vector<schema*>())
+				{
+					string mode = mode_data->value.get_blob();
+					if (options.modes.find(mode) == options.modes.end())
+						continue;
+
+					vector<string> command;
+					if (!prepare(options, name, mode, script, args, command))
+					{
+						VI_ERR("%s benchmark error: cannot prepare %s mode", name.c_str(), mode.c_str());
+						++regressions;
+						continue;
+					}
+
+					vector<benchmark_measurement> measurements;
+					for (size_t i = 0; i < options.repeat; i++)
+						measurements.push_back(measure(options, command, http_data ? &http : nullptr));
+
+					benchmark_measurement result = summarize(measurements);
+					schema* next = results->push(var::set::object());
+					next->set("name", var::string(name));
+					next->set("mode", var::string(mode));
+					next->set("wall_ms", var::number(result.wall_ms));
+					next->set("startup_ms", var::number(result.startup_ms));
+					next->set("peak_rss_kb", var::integer(result.peak_rss_kb));
+					next->set("exit_code", var::integer(result.exit_code));
+					if (http_data != nullptr)
+						next->set("requests_per_second", var::number(result.requests_per_second));
+
+					string status = compare(options, baseline ? baseline->get("results") : nullptr, next);
+					if (!status.empty())
+						++regressions;
+
+					printf("  %-20s %-10s wall %10.2fms  startup %8.2fms  rss %8" PRId64 "kb", name.c_str(), mode.c_str(), result.wall_ms, result.startup_ms, result.peak_rss_kb);
+					if (http_data != nullptr)
+						printf("  %10.0f req/s", result.requests_per_second);
+					printf("%s\n", status.c_str());
+				}
+			}
+
+			string data = schema::to_json(*report);
+			string target = options.update_baseline ? options.baseline : options.output;
+			if (!target.empty() && !os::file::write(target, (uint8_t*)data.data(), data.size()))
+			{
+				VI_ERR("%s benchmark error: write failed", target.c_str());
+				return 1;
+			}
+
+			if (regressions > 0 && !options.update_baseline)
+			{
+				printf("%i regression(s) above %.0f%% threshold\n", (int)regressions, options.threshold * 100.0);
+				return 2;
+			}
+
+			return 0;
+		}
+
+	private:
+		static bool prepare(benchmark_options& options, const string& name, const string& mode, const string& script, const vector<string>& args, vector<string>& command)
+		{
+			if (mode == "source")
+			{
+				command = { options.executable, "--no-cache", script };
+				command.insert(command.end(), args.begin(), args.end());
+				return true;
+			}
+			else if (mode == "bytecode")
+			{
+				if (spawn({ options.executable, "--save-bytecode", script }, nullptr) != 0)
+					return false;
+
+				command = { options.executable, "--load-bytecode", script + ".gz" };
+				command.insert(command.end(), args.begin(), args.end());
+				return true;
+			}
+			else if (mode == "executable" || mode == "aot")
+			{
+				string target = "benchmark_" + name + (mode == "aot" ? "_aot" : "");
+				stringify::replace(target, '-', '_');
+				vector<string> install = { options.executable, "--install", "--target=" + target, "--output=" + options.workspace };
+				if (mode == "aot")
+					install.push_back("--aot");
+				install.push_back(script);
+				if (spawn(install, nullptr) != 0)
+					return false;
+
+				command = { options.workspace + target + VI_SPLITTER + "bin" + VI_SPLITTER + target };
+				command.insert(command.end(), args.begin(), args.end());
+				return true;
+			}
+
+			return false;
+		}
+		static benchmark_measurement measure(benchmark_options& options, const vector<string>& command, benchmark_http* http)
+		{
+			benchmark_measurement result;
+			string profile = options.workspace + "startup.json";
+			os::file::remove(profile);
+
+			auto time = std::chrono::steady_clock::now();
+			result.exit_code = spawn(command, &result.peak_rss_kb, profile, http, &result.requests_per_second);
+			result.wall_ms = (double)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - time).count() / 1000.0;
+
+			auto data = os::file::read_as_string(profile);
+			if (!data)
+				return result;
+
+			auto startup = schema::from_json(*data);
+			if (!startup)
+				return result;
+
+			uptr<schema> info = *startup;
+			result.startup_ms = (double)info->get_var("total_nanoseconds").get_integer() / 1000000.0;
+			return result;
+		}
+		static benchmark_measurement summarize(vector<benchmark_measurement>& measurements)
+		{
+			auto median = [&measurements](double benchmark_measurement::* field)
+			{
+				vector<double> values;
+				for (auto& item : measurements)
+					values.push_back(item.*field);
+				std::sort(values.begin(), values.end());
+				return values[values.size() / 2];
+			};
+
+			benchmark_measurement result;
+			result.wall_ms = median(&benchmark_measurement::wall_ms);
+			result.startup_ms = median(&benchmark_measurement::startup_ms);
+			result.requests_per_second = median(&benchmark_measurement::requests_per_second);
+			for (auto& item : measurements)
+			{
+				result.peak_rss_kb = std::max(result.peak_rss_kb, item.peak_rss_kb);
+				if (item.exit_code != 0 || result.exit_code == -1)
+					result.exit_code = item.exit_code;
+			}
+			return result;
+		}
+		static string compare(benchmark_options& options, schema* baseline, schema* result)
+		{
+			if (result->get_var("exit_code").get_integer() != 0)
+				return "  [FAILED]";
+
+			for (auto* item : baseline ? baseline->get_childs() : vector<schema*>())
+			{
+				if (item->get_var("name").get_blob() != result->get_var("name").get_blob() || item->get_var("mode").get_blob() != result->get_var("mode").get_blob())
+					continue;
+
+				string status;
+				static const char* lower_is_better[] = { "wall_ms", "startup_ms", "peak_rss_kb" };
+				for (auto* field : lower_is_better)
+				{
+					double before = item->get_var(field).get_number(), after = result->get_var(field).get_number();
+					if (before > 0.0 && after > before * (1.0 + options.threshold))
+						status += stringify::text("  [REGRESSION %s %+.1f%%]", field, (after - before) * 100.0 / before);
+				}
+
+				double before = item->get_var("requests_per_second").get_number(), after = result->get_var("requests_per_second").get_number();
+				if (before > 0.0 && after < before * (1.0 - options.threshold))
+					status += stringify::text("  [REGRESSION requests_per_second %+.1f%%]", (after - before) * 100.0 / before);
+
+				return status;
+			}
+
+			return baseline ? "  [NO BASELINE]" : string();
+		}
+		static int spawn(const vector<string>& command, int64_t* peak_rss_kb, const string& profile = string(), benchmark_http* http = nullptr, double* requests_per_second = nullptr)
+		{
+#ifdef VI_UNIX
+			pid_t pid = fork();
+			if (pid == 0)
+			{
+				vector<char*> argv;
+				for (auto& item : command)
+					argv.push_back((char*)item.c_str());
+				argv.push_back(nullptr);
+
+				if (!profile.empty())
+					setenv("ASX_PROFILE_STARTUP", profile.c_str(), 1);
+				if (!profile.empty())
+				{
+					int null_fd = open("/dev/null", O_WRONLY);
+					dup2(null_fd, STDOUT_FILENO);
+				}
+
+				execvp(argv[0], argv.data());
+				_exit(127);
+			}
+			else if (pid < 0)
+				return -1;
+
+			if (http != nullptr)
+			{
+				*requests_per_second = generate_load(*http);
+				kill(pid, SIGTERM);
+			}
+
+			int status = 0;
+			struct rusage usage;
+			memset(&usage, 0, sizeof(usage));
+			if (wait4(pid, &status, 0, &usage) < 0)
+				return -1;
+#ifdef __APPLE__
+			if (peak_rss_kb != nullptr)
+				*peak_rss_kb = (int64_t)usage.ru_maxrss / 1024;
+#else
+			if (peak_rss_kb != nullptr)
+				*peak_rss_kb = (int64_t)usage.ru_maxrss;
+#endif
+			if (http != nullptr && WIFEXITED(status) && WEXITSTATUS(status) == 0)
+				return 0;
+
+			return WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+#else
+			string data;
+			for (auto& item : command)
+				data += "\"" + item + "\" ";
+			if (!profile.empty())
+				_putenv_s("ASX_PROFILE_STARTUP", profile.c_str());
+			return std::system(data.c_str());
+#endif
+		}
+#ifdef VI_UNIX
+		static double generate_load(benchmark_http& http)
+		{
+			auto connect_to = [&http]() -> int
+			{
+				int fd = socket(AF_INET, SOCK_STREAM, 0);
+				sockaddr_in address;
+				memset(&address, 0, sizeof(address));
+				address.sin_family = AF_INET;
+				address.sin_port = htons(http.port);
+				address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+				if (fd >= 0 && connect(fd, (sockaddr*)&address, sizeof(address)) == 0)
+					return fd;
+				if (fd >= 0)
+					close(fd);
+				return -1;
+			};
+
+			auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+			for (int fd = connect_to(); fd < 0; fd = connect_to())
+			{
+				if (std::chrono::steady_clock::now() > deadline)
+					return 0.0;
+				std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			}
+
+			string request = "GET " + http.path + " HTTP/1.1\r\nHost: 127.0.0.1\r\nConnection: keep-alive\r\n\r\n";
+			std::atomic<size_t> remaining = { http.requests };
+			std::atomic<size_t> completed = { 0 };
+			vector<std::thread> workers;
+			auto time = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < std::max<size_t>(1, http.connections); i++)
+			{
+				workers.emplace_back([&]()
+				{
+					int fd = connect_to();
+					char buffer[16384];
+					string response;
+					while (fd >= 0 && remaining.fetch_sub(1) > 0)
+					{
+						if (send(fd, request.data(), request.size(), MSG_NOSIGNAL) != (ssize_t)request.size())
+							break;
+
+						response.clear();
+						size_t header_size = string::npos, content_length = 0;
+						while (header_size == string::npos || response.size() < header_size + content_length)
+						{
+							ssize_t size = recv(fd, buffer, sizeof(buffer), 0);
+							if (size <= 0)
+								goto finish;
+
+							response.append(buffer, (size_t)size);
+							if (header_size != string::npos)
+								continue;
+
+							size_t offset = response.find("\r\n\r\n");
+							if (offset == string::npos)
+								continue;
+
+							header_size = offset + 4;
+							string headers = response.substr(0, header_size);
+							stringify::to_lower(headers);
+							size_t length = headers.find("content-length:");
+							if (length != string::npos)
+								content_length = (size_t)strtoull(headers.c_str() + length + 15, nullptr, 10);
+						}
+						++completed;
+					}
+				finish:
+					if (fd >= 0)
+						close(fd);
+				});
+			}
+
+			for (auto& worker : workers)
+				worker.join();
+
+			double seconds = (double)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - time).count() / 1000000.0;
+			return seconds > 0.0 ? (double)completed.load() / seconds : 0.0;
+		}
+#endif
+	};
+}
+
+int main(int argc, char* argv[])
+{
+	vitex::heavy_runtime scope(vitex::use_locale);
+	auto args = os::process::parse_args(argc, argv, (size_t)args_format::key_value | (size_t)args_format::flag_value, { "update-baseline" });
+	auto get_arg = [&args](const char* name) { auto it = args.args.find(name); return it != args.args.end() ? it->second : string(); };
+	if (args.params.size() < 2)
+	{
+		printf("usage: asx_benchmark <asx executable> <suite.json> [--baseline=path] [--output=path] [--modes=source+bytecode+executable+aot] [--update-baseline]\n");
+		return 1;
+	}
+
+	string directory = *os::directory::get_working();
+	auto executable = os::path::resolve(args.params[0], directory, true);
+	auto suite = os::path::resolve(args.params[1], directory, true);
+	if (!executable || !suite)
+	{
+		VI_ERR("benchmark error: invalid executable or suite path");
+		return 1;
+	}
+
+	asx::benchmark_options options;
+	options.executable = *executable;
+	options.suite = *suite;
+	options.examples = os::path::get_directory(options.suite.c_str()) + ".." + VI_SPLITTER + "examples" + VI_SPLITTER;
+	options.workspace = os::path::get_directory(options.suite.c_str()) + ".workspace" + VI_SPLITTER;
+	options.baseline = args.has("baseline") ? get_arg("baseline") : os::path::get_directory(options.suite.c_str()) + "baseline.json";
+	options.output = get_arg("output");
+	options.update_baseline = args.has("update-baseline");
+	if (args.has("modes"))
+	{
+		options.modes.clear();
+		for (auto& mode : stringify::split(get_arg("modes"), '+'))
+			options.modes.insert(mode);
+	}
+
+	os::directory::patch(options.workspace);
+	return asx::benchmark_suite::execute(options);
+}
@@ -1,6 +1,12 @@
 #include "builder.h"
 #include "code.hpp"
 #include <iostream>
+#include <random>
+#ifdef VI_MICROSOFT
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
 #define REPOSITORY_SOURCE "https://github.com/"
 #define REPOSITORY_TARGET_VENGEANCE "https://github.com/romanpunia/vengeance"
 #define REPOSITORY_FILE_INDEX "addon.as"
@@ -17,13 +23,43 @@ namespace asx
 		new_value += '\"';
 		return new_value;
 	}
+	static string format_temporary_path(const std::string_view& path)
+	{
+		/* several processes may share one cache, so temporary names carry pid and a random part */
+		static std::atomic<uint32_t> counter = { 0 };
+#ifdef VI_MICROSOFT
+		uint64_t process = (uint64_t)GetCurrentProcessId();
+#else
+		uint64_t process = (uint64_t)getpid();
+#endif
+		uint32_t salt = std::random_device()() ^ ++counter;
+		return stringify::text("%.*s.%" PRIu64 ".%08x.tmp", (int)path.size(), path.data(), process, salt);
+	}
+	static bool write_file_atomic(const string& path, const uint8_t* data, size_t size)
+	{
+		string temporary_path = format_temporary_path(path);
+		if (os::file::write(temporary_path, data, size) && os::file::move(temporary_path.c_str(), path.c_str()))
+			return true;
+
+		os::file::remove(temporary_path.c_str());
+		return false;
+	}
 
-	status_code builder::compile_into_addon(system_config& config, environment_config& env, virtual_machine* vm, const std::string_view& name, string& output)
+	status_code builder::fetch_into_addon(system_config& config, environment_config& env, const std::string_view& name, string& output)
 	{
 		string local_target = env.registry + string(name), remote_target = string(name.substr(1));
-		if (is_directory_empty(local_target) && execute_git(config, "git clone " REPOSITORY_SOURCE + remote_target + " \"" + local_target + "\"") != status_code::OK)
+		string source = get_addon_source(env, name);
+		auto lock = env.locked_addons.find(string(name));
+		string commit = lock != env.locked_addons.end() ? lock->second.first : string();
+		if (is_directory_empty(local_target) && execute_git(config, commit.empty() ? "git clone --depth 1 " + source + " \"" + local_target + "\"" : "git init \"" + local_target + "\"") != status_code::OK)
+		{
+			VI_ERR("%s import error: repository cannot be cloned", remote_target.c_str());
+			return status_code::command_error;
+		}
+
+		if (!commit.empty() && get_addon_revision(env, name) != commit && execute_git(config, "cd \"" + local_target + "\" && git fetch --depth 1 " + source + " " + commit + " && git checkout --detach FETCH_HEAD") != status_code::OK)
 		{
-			VI_ERR("%s import error: <%s>", remote_target.c_str());
+			VI_ERR("%s import error: locked revision %s cannot be fetched", remote_target.c_str(), commit.c_str());
 			return status_code::command_error;
 		}
 
@@ -43,49 +79,9 @@ namespace asx
 				return status_code::configuration_error;
 			}
 
-			string build_directory = get_building_directory(env, local_target);
-			string sh_local_target = format_directory_path(local_target);
-			string sh_build_directory = format_directory_path(build_directory);
-			os::directory::remove(build_directory.c_str());
-#if defined(VI_MICROSOFT) || defined(VI_APPLE)
-			string configure_command = stringify::text("cmake -S %s -B %s", sh_local_target.c_str(), sh_build_directory.c_str());
-#else
-			string configure_command = stringify::text("cmake -S %s -B %s -DCMAKE_BUILD_TYPE=%s", sh_local_target.c_str(), sh_build_directory.c_str(), get_build_type(config));
-#endif
-			if (execute_cmake(config, configure_command) != status_code::OK)
-			{
-				VI_ERR("%s import error: final target cannot be configured", name.data());
-				return status_code::configuration_error;
-			}
-#if defined(VI_MICROSOFT) || defined(VI_APPLE)
-			string build_command = stringify::text("cmake --build %s --config %s", sh_build_directory.c_str(), get_build_type(config));
-#else
-			string build_command = stringify::text("cmake --build %s", sh_build_directory.c_str());
-#endif
-			if (execute_cmake(config, build_command) != status_code::OK)
-			{
-				VI_ERR("%s import error: final target cannot be built", name.data());
-				return status_code::build_error;
-			}
-
-			string addon_name = string(os::path::get_filename(name));
-			string target_path = get_addon_target(env, name);
-			string next_path = get_global_targets_directory(env, name) + VI_SPLITTER;
-			os::directory::patch(next_path);
-
-			vector<std::pair<string, file_entry>> files;
-			string prev_path = get_local_targets_directory(env, name) + VI_SPLITTER;
-			os::directory::scan(prev_path, files);
-			for (auto& file : files)
-			{
-				string next_file_path = next_path + file.first;
-				string prev_file_path = prev_path + file.first;
-                if (!file.second.is_directory)
-					os::file::move(prev_file_path.c_str(), next_file_path.c_str());
-			}
-
-			os::directory::remove(prev_path.c_str());
-			return vm->import_addon(target_path) ? status_code::OK : status_code::dependency_error;
+			if (std::find(env.pending_addons.begin(), env.pending_addons.end(), name) == env.pending_addons.end())
+				env.pending_addons.push_back(string(name));
+			return status_code::OK;
 		}
 		else if (type == "vm")
 		{
@@ -110,6 +106,47 @@ namespace asx
 		VI_ERR("%s import error: bad " REPOSITORY_FILE_ADDON " file; %s not acceptable", name.data(), type.c_str());
 		return status_code::configuration_error;
 	}
+	status_code builder::compile_into_addons(system_config& config, environment_config& env, virtual_machine* vm)
+	{
+		vector<string> names = std::move(env.pending_addons);
+		env.pending_addons.clear();
+		if (names.empty())
+			return status_code::OK;
+
+		size_t jobs = std::max<size_t>(1, std::min<size_t>(config.jobs, names.size()));
+		size_t parallel = config.jobs > 1 ? std::max<size_t>(1, config.jobs / jobs) : 0;
+		vector<status_code> statuses(names.size(), status_code::OK);
+		std::atomic<size_t> next = 0;
+		auto build = [&]()
+		{
+			size_t index;
+			while ((index = next++) < names.size())
+				statuses[index] = build_into_addon(config, env, names[index], parallel);
+		};
+
+		vector<std::thread> threads;
+		threads.reserve(jobs - 1);
+		for (size_t i = 1; i < jobs; i++)
+			threads.emplace_back(build);
+
+		build();
+		for (auto& thread : threads)
+			thread.join();
+
+		status_code status = status_code::OK;
+		for (size_t i = 0; i < names.size(); i++)
+		{
+			if (statuses[i] != status_code::OK)
+				status = statuses[i];
+			else if (!vm->import_addon(get_addon_target(env, names[i])))
+			{
+				VI_ERR("%s import error: final target cannot be loaded", names[i].c_str());
+				status = status_code::dependency_error;
+			}
+		}
+
+		return status;
+	}
 	status_code builder::import_into_addon(environment_config& env, virtual_machine* vm, const std::string_view& name, string& output)
 	{
 		uptr<schema> info = get_addon_info(env, name);
@@ -226,11 +263,20 @@ namespace asx
 
 				for (auto& addon : addons)
 				{
-					if (addon.second.is_directory && !pull(repositories_path + addon.first))
+					if (!addon.second.is_directory)
+						continue;
+
+					string name = file.first + "/" + addon.first;
+					string revision = get_addon_revision(env, name);
+					if (execute_git(config, "cd \"" + repositories_path + addon.first + "\" && git fetch --depth 1 origin HEAD && git checkout --detach FETCH_HEAD") != status_code::OK)
 					{
 						VI_ERR("%s pull error: failed", file.first.c_str());
 						return status_code::command_error;
 					}
+
+					uptr<schema> info = get_addon_info(env, name);
+					if (info && info->get_var("type").get_blob() == "native" && get_addon_revision(env, name) != revision)
+						env.pending_addons.push_back(name);
 				}
 			}
 			else if (!pull(env.registry + file.first))
@@ -249,6 +295,83 @@ namespace asx
 
 		return status_code::OK;
 	}
+	bool builder::load_addon_lock(environment_config& env)
+	{
+		env.locked_addons.clear();
+		auto data = os::file::read_as_string(get_addon_lock_path(env));
+		if (!data)
+			return false;
+
+		auto result = schema::from_json(*data);
+		if (!result)
+		{
+			VI_WARN("%s lock error: bad lock file, ignoring", get_addon_lock_path(env).c_str());
+			return false;
+		}
+
+		uptr<schema> lock = *result;
+		schema* addons = lock->get("addons");
+		if (addons != nullptr)
+		{
+			for (auto* item : addons->get_childs())
+			{
+				string name = item->get_var("name").get_blob();
+				if (!name.empty() && name.front() == '@')
+					env.locked_addons[name] = std::make_pair(item->get_var("commit").get_blob(), item->get_var("hash").get_blob());
+			}
+		}
+
+		return true;
+	}
+	bool builder::store_addon_lock(environment_config& env, virtual_machine* vm)
+	{
+		vector<string> names(env.addons.begin(), env.addons.end());
+		std::sort(names.begin(), names.end());
+
+		uptr<schema> lock = var::set::object();
+		schema* addons = lock->set("addons", var::set::array());
+		for (auto& name : names)
+		{
+			schema* addon = addons->push(var::set::object());
+			addon->set("name", var::string(name));
+			addon->set("commit", var::string(get_addon_revision(env, name)));
+			addon->set("hash", var::string(get_addon_hash(env, vm, name)));
+		}
+
+		string data = schema::to_json(*lock);
+		return update_file(get_addon_lock_path(env), (uint8_t*)data.data(), data.size());
+	}
+	bool builder::is_addon_locked(environment_config& env, virtual_machine* vm, const std::string_view& name)
+	{
+		auto it = env.locked_addons.find(string(name));
+		if (it == env.locked_addons.end())
+			return true;
+
+		if (get_addon_revision(env, name) != it->second.first)
+		{
+			VI_DEBUG("%s lock mismatch: revision differs from %s", name.data(), it->second.first.c_str());
+			return false;
+		}
+
+		return true;
+	}
+	bool builder::is_addon_modified(environment_config& env, virtual_machine* vm, const std::string_view& name)
+	{
+		/* same commit must give the same artifact, rebuilding and relocking would hide a tampered or nondeterministic build */
+		auto it = env.locked_addons.find(string(name));
+		if (it == env.locked_addons.end() || it->second.second.empty() || !is_addon_target_exists(env, vm, name))
+			return false;
+
+		if (get_addon_revision(env, name) != it->second.first)
+			return false;
+
+		string hash = get_addon_hash(env, vm, name);
+		if (hash == it->second.second)
+			return false;
+
+		VI_ERR("%s lock error: artifact hash %s differs from locked %s at the same commit, remove addon from %s to accept it", name.data(), hash.c_str(), it->second.second.c_str(), get_addon_lock_path(env).c_str());
+		return true;
+	}
 	status_code builder::compile_into_executable(system_config& config, environment_config& env, virtual_machine* vm, const unordered_map<string, uint32_t>& settings)
 	{
 		string vitex_directory = get_global_vitex_path();
@@ -259,6 +382,13 @@ namespace asx
 		}
 
 		unordered_map<string, string> keys = get_build_keys(config, env, vm, settings, false);
+		string library_path;
+		if (!config.pgo && !append_vitex_library(config, keys, library_path))
+		{
+			VI_WARN("library error: prebuilt vitex is not available, building from sources");
+			library_path.clear();
+		}
+
 		unordered_map<string, string> files =
 		{
 			{ "executable/CMakeLists.txt", "" },
@@ -283,12 +413,19 @@ namespace asx
 				return status_code::generation_error;
 		}
 
-		if (!append_byte_code(config, env, env.output + "program.b64"))
+		if (!append_byte_code(config, env, env.output + "program.bin"))
 		{
 			VI_ERR("embed error: program embedding failed");
 			return status_code::byte_code_error;
 		}
 
+		bool translated = false;
+		if (!append_native_code(config, env, env.output + "aot.cpp", translated))
+		{
+			VI_ERR("aot error: native code generation failed");
+			return status_code::generation_error;
+		}
+
 		if (!append_dependencies(env, vm, env.output + "bin/"))
 		{
             VI_ERR("embed error: dependency embedding failed");
@@ -298,32 +435,43 @@ namespace asx
 		string sh_output_source = format_directory_path(env.output);
 		string sh_output_build = format_directory_path(env.output + "make");
 		string sh_vitex_directory = format_directory_path(vitex_directory);
+		string sh_library_path = "\"" + library_path + "\"";
 #if defined(VI_MICROSOFT) || defined(VI_APPLE)
-		string configure_command = stringify::text("cmake -S %s -B %s -DVI_DIRECTORY=%s -DVI_CXX=%i", sh_output_source.c_str(), sh_output_build.c_str(), sh_vitex_directory.c_str(), VI_CXX);
+		string configure_command = stringify::text("cmake -S %s -B %s -DVI_DIRECTORY=%s -DVI_LIBRARY=%s -DVI_CXX=%i", sh_output_source.c_str(), sh_output_build.c_str(), sh_vitex_directory.c_str(), sh_library_path.c_str(), VI_CXX);
 #else
-		string configure_command = stringify::text("cmake -S %s -B %s -DVI_DIRECTORY=%s -DVI_CXX=%i -DCMAKE_BUILD_TYPE=%s", sh_output_source.c_str(), sh_output_build.c_str(), sh_vitex_directory.c_str(), VI_CXX, get_build_type(config));
+		string configure_command = stringify::text("cmake -S %s -B %s -DVI_DIRECTORY=%s -DVI_LIBRARY=%s -DVI_CXX=%i -DCMAKE_BUILD_TYPE=%s", sh_output_source.c_str(), sh_output_build.c_str(), sh_vitex_directory.c_str(), sh_library_path.c_str(), VI_CXX, get_build_type(config));
 #endif
-		if (execute_cmake(config, configure_command) != status_code::OK)
+		configure_command += config.lto ? " -DVI_LTO=ON" : " -DVI_LTO=OFF";
+		configure_command += translated ? " -DVI_AOT=ON" : " -DVI_AOT=OFF";
+		if (!config.pgo)
+			return build_into_executable(config, env, configure_command + " -DVI_PGO=");
+
+		string profile_directory = env.output + "make" + VI_SPLITTER + "pgo";
+		string sh_profile_directory = format_directory_path(profile_directory);
+		os::directory::remove(profile_directory.c_str());
+		os::directory::patch(profile_directory);
+
+		status_code status = build_into_executable(config, env, configure_command + " -DVI_PGO=generate -DVI_PGO_DIRECTORY=" + sh_profile_directory);
+		if (status != status_code::OK)
+			return status;
+
+		string training_command = env.pgo_training;
+		if (training_command.empty())
 		{
+			string executable_path = env.output + "bin" + VI_SPLITTER + (env.name.empty() ? "build_target" : env.name);
 #ifdef VI_MICROSOFT
-			VI_ERR("configure error: possibly missing vcpkg");
-#else
-            VI_ERR("configure error: possibly missing dependencies");
+			executable_path += ".exe";
 #endif
-			return status_code::configuration_error;
+			training_command = "\"" + executable_path + "\"";
 		}
-#if defined(VI_MICROSOFT) || defined(VI_APPLE)
-		string build_command = stringify::text("cmake --build %s --config %s", sh_output_build.c_str(), get_build_type(config));
-#else
-		string build_command = stringify::text("cmake --build %s", sh_output_build.c_str());
-#endif
-		if (execute_cmake(config, build_command) != status_code::OK)
+
+		if (!execute_command(config, "TRAIN", training_command, 0x0))
 		{
-			VI_ERR("build error: failed");
-			return status_code::build_error;
+			VI_ERR("pgo error: training run failed");
+			return status_code::command_error;
 		}
 
-		return status_code::OK;
+		return build_into_executable(config, env, configure_command + " -DVI_PGO=use -DVI_PGO_DIRECTORY=" + sh_profile_directory);
 	}
 	unordered_map<string, uint32_t> builder::get_default_settings()
 	{
@@ -370,6 +518,27 @@ namespace asx
 		settings["foreach_support"] = (uint32_t)features::foreach_support;
 		return settings;
 	}
+	size_t builder::get_init_modules(const vector<string>& system_addons, bool native_imports)
+	{
+		static const char* offline_addons[] =
+		{
+			"ctypes", "any", "array", "complex", "dictionary", "string", "math", "decimal", "uint128", "uint256",
+			"variant", "timestamp", "console", "schema", "clock", "fs", "os", "regex", "buffers", "promise", "thread", "codec"
+		};
+
+		size_t offline_modules = vitex::use_locale;
+		size_t online_modules = offline_modules | vitex::use_networking | vitex::use_cryptography | vitex::use_providers;
+		if (native_imports)
+			return online_modules;
+
+		for (auto& name : system_addons)
+		{
+			if (std::find_if(std::begin(offline_addons), std::end(offline_addons), [&name](const char* item) { return name == item; }) == std::end(offline_addons))
+				return online_modules;
+		}
+
+		return offline_modules;
+	}
 	string builder::get_system_version()
 	{
 		return to_string((size_t)vitex::major_version) + '.' + to_string((size_t)vitex::minor_version) + '.' + to_string((size_t)vitex::patch_version) + '.' + to_string((size_t)vitex::build_version);
@@ -389,47 +558,145 @@ namespace asx
 
 		return execute_command(config, "RUN", command, 0x0) ? status_code::OK : status_code::command_error;
 	}
-	status_code builder::execute_cmake(system_config& config, const std::string_view& command)
+	status_code builder::execute_cmake(system_config& config, const std::string_view& command, const std::string_view& prefix)
 	{
-		static int is_cmake_installed = -1;
-		if (is_cmake_installed == -1)
+		static bool is_cmake_installed = execute_command(config, "FIND", "cmake", 0x0);
+		if (!is_cmake_installed)
 		{
-			is_cmake_installed = execute_command(config, "FIND", "cmake", 0x0) ? 1 : 0;
-			if (!is_cmake_installed)
-			{
-                VI_ERR("find error: cmake not found");
-				return status_code::command_not_found;
-			}
+			VI_ERR("find error: cmake not found");
+			return status_code::command_not_found;
 		}
 
-		return execute_command(config, "RUN", command, 0x0) ? status_code::OK : status_code::command_error;
+		return execute_command(config, "RUN", command, 0x0, prefix) ? status_code::OK : status_code::command_error;
+	}
+	status_code builder::build_into_addon(system_config& config, environment_config& env, const std::string_view& name, size_t parallel)
+	{
+		string next_path = get_global_targets_directory(env, name) + VI_SPLITTER;
+		string cache_directory = get_addon_cache_directory(config, env, name);
+		os::directory::patch(next_path);
+		if (!cache_directory.empty() && restore_addon_cache(cache_directory, next_path))
+		{
+			VI_DEBUG("%s restored from build cache: %s", name.data(), cache_directory.c_str());
+			return status_code::OK;
+		}
+
+		string local_target = env.registry + string(name);
+		string build_directory = get_building_directory(env, local_target);
+		string sh_local_target = format_directory_path(local_target);
+		string sh_build_directory = format_directory_path(build_directory);
+		os::directory::remove(build_directory.c_str());
+#if defined(VI_MICROSOFT) || defined(VI_APPLE)
+		string configure_command = stringify::text("cmake -S %s -B %s", sh_local_target.c_str(), sh_build_directory.c_str());
+#else
+		string configure_command = stringify::text("cmake -S %s -B %s -DCMAKE_BUILD_TYPE=%s", sh_local_target.c_str(), sh_build_directory.c_str(), get_build_type(config));
+#endif
+		if (execute_cmake(config, configure_command, name) != status_code::OK)
+		{
+			VI_ERR("%s import error: final target cannot be configured", name.data());
+			return status_code::configuration_error;
+		}
+#if defined(VI_MICROSOFT) || defined(VI_APPLE)
+		string build_command = stringify::text("cmake --build %s --config %s", sh_build_directory.c_str(), get_build_type(config));
+#else
+		string build_command = stringify::text("cmake --build %s", sh_build_directory.c_str());
+#endif
+		if (parallel > 0)
+			build_command += " --parallel " + to_string(parallel);
+
+		if (execute_cmake(config, build_command, name) != status_code::OK)
+		{
+			VI_ERR("%s import error: final target cannot be built", name.data());
+			return status_code::build_error;
+		}
+
+		vector<string> targets;
+		vector<std::pair<string, file_entry>> files;
+		string prev_path = get_local_targets_directory(env, name) + VI_SPLITTER;
+		os::directory::scan(prev_path, files);
+		for (auto& file : files)
+		{
+			string next_file_path = next_path + file.first;
+			string prev_file_path = prev_path + file.first;
+			if (!file.second.is_directory && os::file::move(prev_file_path.c_str(), next_file_path.c_str()))
+				targets.push_back(file.first);
+		}
+
+		os::directory::remove(prev_path.c_str());
+		os::directory::remove(build_directory.c_str());
+		if (!cache_directory.empty() && !targets.empty())
+			store_addon_cache(cache_directory, next_path, targets);
+		return status_code::OK;
+	}
+	status_code builder::build_into_executable(system_config& config, environment_config& env, const std::string_view& configure_command)
+	{
+		string sh_output_build = format_directory_path(env.output + "make");
+		string configure_stamp = env.output + "make" + VI_SPLITTER + "asx.configure";
+		auto last_configure_command = os::file::read_as_string(configure_stamp.c_str());
+		if (last_configure_command && *last_configure_command == configure_command && os::file::is_exists((env.output + "make" + VI_SPLITTER + "CMakeCache.txt").c_str()))
+			VI_DEBUG("configure skipped: %s is up to date", sh_output_build.c_str());
+		else if (execute_cmake(config, configure_command) != status_code::OK)
+		{
+			os::file::remove(configure_stamp.c_str());
+#ifdef VI_MICROSOFT
+			VI_ERR("configure error: possibly missing vcpkg");
+#else
+            VI_ERR("configure error: possibly missing dependencies");
+#endif
+			return status_code::configuration_error;
+		}
+		else
+			os::file::write(configure_stamp, (uint8_t*)configure_command.data(), configure_command.size());
+#if defined(VI_MICROSOFT) || defined(VI_APPLE)
+		string build_command = stringify::text("cmake --build %s --config %s", sh_output_build.c_str(), get_build_type(config));
+#else
+		string build_command = stringify::text("cmake --build %s", sh_output_build.c_str());
+#endif
+		if (config.jobs > 1)
+			build_command += " --parallel " + to_string(config.jobs);
+
+		if (execute_cmake(config, build_command) != status_code::OK)
+		{
+			VI_ERR("build error: failed");
+			return status_code::build_error;
+		}
+
+		return status_code::OK;
 	}
-	bool builder::execute_command(system_config& config, const std::string_view& label, const std::string_view& command, int success_exit_code)
+	bool builder::execute_command(system_config& config, const std::string_view& label, const std::string_view& command, int success_exit_code, const std::string_view& prefix)
 	{
+		static std::mutex output_mutex;
 		auto time = schedule::get_clock();
 		auto* terminal = console::get();
+        string tag = prefix.empty() ? string() : "[" + string(prefix) + "] ";
         size_t messages = 0;
-        terminal->write("> ");
-        terminal->write_color(std_color::yellow);
-        terminal->write("[PENDING] ");
-        terminal->clear_color();
-        terminal->write_line(string(label) + " " + string(command));
+        {
+            std::unique_lock<std::mutex> unique(output_mutex);
+            terminal->write("> ");
+            terminal->write_color(std_color::yellow);
+            terminal->write("[PENDING] ");
+            terminal->clear_color();
+            terminal->write_line(tag + string(label) + " " + string(command));
+        }
         
-        auto exit_code = os::process::execute(command, file_mode::read_only, [terminal, &messages](const std::string_view& buffer)
+        auto exit_code = os::process::execute(command, file_mode::read_only, [terminal, &tag, &messages](const std::string_view& buffer)
         {
             size_t index = ++messages;
-            terminal->write((index < 100 ? (index < 10 ? "[00" : "[0") : "[") + to_string(index) + "]  " + string(buffer));
+            {
+                std::unique_lock<std::mutex> unique(output_mutex);
+                terminal->write(tag + (index < 100 ? (index < 10 ? "[00" : "[0") : "[") + to_string(index) + "]  " + string(buffer));
+            }
             std::this_thread::sleep_for(std::chrono::milliseconds(5));
             return true;
         });
 
         bool success = exit_code && *exit_code == success_exit_code;
         auto diff = (schedule::get_clock() - time).count() / 1000000.0;
+        std::unique_lock<std::mutex> unique(output_mutex);
         terminal->write("> ");
         terminal->write_color(success ? std_color::green : std_color::red);
         terminal->write(success ? "[OK]" : "[ERROR]");
         terminal->clear_color();
-        terminal->write_line(" " + string(label) + " " + string(command) + " - " + to_string(diff) + " seconds");
+        terminal->write_line(" " + tag + string(label) + " " + string(command) + " - " + to_string(diff) + " seconds");
         if (!exit_code)
             terminal->write_line(exit_code.what());
         else if (!success)
@@ -457,7 +724,7 @@ namespace asx
 		if (path.back() != '/' && path.back() != '\\')
 			path += VI_SPLITTER;
 
-		if (!os::file::write(path + filename, (uint8_t*)file->data(), file->size()))
+		if (!update_file(path + filename, (uint8_t*)file->data(), file->size()))
 		{
 			VI_ERR("%s template error: write failed", target_path.data());
 			return false;
@@ -476,21 +743,36 @@ namespace asx
 		}
 
 		os::directory::patch(os::path::get_directory(path));
-		uptr<stream> target_file = os::file::open(path, file_mode::binary_write_only).or_else(nullptr);
-		if (!target_file)
+		if (!update_file(path, (uint8_t*)info.data.data(), info.data.size()))
 		{
-			VI_ERR("%s open error: failed", path.data());
+            VI_ERR("%s write error: failed", path.data());
 			return false;
 		}
 
-		string data = codec::base64_encode(std::string_view((char*)info.data.data(), info.data.size()));
-		if (target_file->write((uint8_t*)data.data(), data.size()).or_else(0) != data.size())
+		return true;
+	}
+	bool builder::append_native_code(system_config& config, environment_config& env, const std::string_view& path, bool& translated)
+	{
+		string target_path = string(path);
+		translated = false;
+		if (!config.aot)
 		{
-            VI_ERR("%s write error: failed", path.data());
-			return false;
+			os::file::remove(target_path.c_str());
+			return true;
 		}
 
-		return true;
+		string output;
+		size_t count = aot_translator::translate(env.this_compiler, output);
+		if (!count)
+		{
+			VI_WARN("aot warning: no functions could be translated, program will be interpreted");
+			os::file::remove(target_path.c_str());
+			return true;
+		}
+
+		VI_DEBUG("aot translated %i functions into %s", (int)count, target_path.c_str());
+		translated = update_file(target_path, (uint8_t*)output.data(), output.size());
+		return translated;
 	}
 	bool builder::append_dependencies(environment_config& env, virtual_machine* vm, const std::string_view& target_directory)
 	{
@@ -520,6 +802,42 @@ namespace asx
 		os::directory::patch(source_path);
 		return execute_git(config, "git clone --recursive " REPOSITORY_TARGET_VENGEANCE " \"" + source_path + "\"") == status_code::OK;
 	}
+	bool builder::append_vitex_library(system_config& config, const unordered_map<string, string>& keys, string& library_path)
+	{
+		auto* lib = vitex::runtime::get();
+		auto features = keys.find("BUILDER_FEATURES");
+		string key = string(lib->get_compiler()) + ':' + string(lib->get_platform()) + ':' + get_build_type(config) + ':' + to_string(VI_CXX) + ':' + get_system_version() + (config.lto ? ":lto" : "");
+		if (features != keys.end())
+			key += ':' + features->second;
+
+		string library_directory = get_global_vitex_path() + VI_SPLITTER + ".library" + VI_SPLITTER + code_cache::get_hash(key) + VI_SPLITTER;
+		string build_directory = library_directory + "make";
+		string sh_library_directory = format_directory_path(library_directory);
+		string sh_build_directory = format_directory_path(build_directory);
+		if (!os::file::is_exists((build_directory + VI_SPLITTER + "CMakeCache.txt").c_str()))
+		{
+			if (!append_template(keys, library_directory, "library/CMakeLists.txt"))
+				return false;
+
+			string configure_command = stringify::text("cmake -S %s -B %s -DVI_CXX=%i -DVI_LTO=%s -DCMAKE_BUILD_TYPE=%s", sh_library_directory.c_str(), sh_build_directory.c_str(), VI_CXX, config.lto ? "ON" : "OFF", get_build_type(config));
+			if (execute_cmake(config, configure_command) != status_code::OK)
+			{
+				os::directory::remove(build_directory.c_str());
+				return false;
+			}
+		}
+
+		string build_command = stringify::text("cmake --build %s --config %s", sh_build_directory.c_str(), get_build_type(config));
+		if (config.jobs > 1)
+			build_command += " --parallel " + to_string(config.jobs);
+
+		if (execute_cmake(config, build_command) != status_code::OK)
+			return false;
+
+		library_path = build_directory + VI_SPLITTER + "vitex-" + get_build_type(config) + ".cmake";
+		stringify::replace(library_path, '\\', '/');
+		return os::file::is_exists(library_path.c_str());
+	}
 	bool builder::is_addon_target_exists(environment_config& env, virtual_machine* vm, const std::string_view& name, bool nested)
 	{
 		string local_target = string(nested ? name : get_addon_target(env, name));
@@ -550,11 +868,83 @@ namespace asx
 
 		return false;
 	}
+	bool builder::read_byte_code(const std::string_view& path, byte_code_info* info)
+	{
+		/* engine deserializes bytecode into its own structures, so file is read once instead of being mapped */
+		auto data = os::file::read_as_string(path);
+		if (!data || data->empty())
+			return false;
+
+		info->data.insert(info->data.end(), data->begin(), data->end());
+		return true;
+	}
+	bool builder::update_file(const std::string_view& path, const uint8_t* data, size_t size)
+	{
+		string target_path = string(path);
+		file_entry state;
+		if (os::file::get_state(target_path, &state) && !state.is_directory && state.size == size)
+		{
+			auto current = os::file::read_as_string(target_path.c_str());
+			if (current && current->size() == size && (!size || !memcmp(current->data(), data, size)))
+				return true;
+		}
+
+		return !!os::file::write(target_path, data, size);
+	}
 	bool builder::is_directory_empty(const std::string_view& target)
 	{
 		vector<std::pair<string, file_entry>> entries;
 		return !os::directory::scan(target, entries) || entries.empty();
 	}
+	bool builder::restore_addon_cache(const std::string_view& cache_directory, const std::string_view& target_directory)
+	{
+		vector<std::pair<string, file_entry>> entries;
+		if (!os::directory::scan(cache_directory, entries) || entries.empty())
+			return false;
+
+		for (auto& file : entries)
+		{
+			if (!file.second.is_directory && !link_file(string(cache_directory) + VI_SPLITTER + file.first, string(target_directory) + file.first))
+				return false;
+		}
+
+		return true;
+	}
+	bool builder::store_addon_cache(const std::string_view& cache_directory, const std::string_view& target_directory, const vector<string>& files)
+	{
+		string temporary_directory = format_temporary_path(cache_directory);
+		os::directory::remove(temporary_directory.c_str());
+		if (!os::directory::patch(temporary_directory))
+			return false;
+
+		for (auto& file : files)
+		{
+			if (!link_file(string(target_directory) + file, temporary_directory + VI_SPLITTER + file))
+			{
+				os::directory::remove(temporary_directory.c_str());
+				return false;
+			}
+		}
+
+		if (os::file::move(temporary_directory.c_str(), string(cache_directory).c_str()))
+			return true;
+
+		os::directory::remove(temporary_directory.c_str());
+		return false;
+	}
+	bool builder::link_file(const std::string_view& from, const std::string_view& to)
+	{
+		string from_path = string(from), to_path = string(to);
+		os::file::remove(to_path.c_str());
+#ifdef VI_MICROSOFT
+		if (CreateHardLinkA(to_path.c_str(), from_path.c_str(), nullptr))
+			return true;
+#else
+		if (::link(from_path.c_str(), to_path.c_str()) == 0)
+			return true;
+#endif
+		return !!os::file::copy(from_path.c_str(), to_path.c_str());
+	}
 	const char* builder::get_build_type(system_config& config)
 	{
 #ifndef NDEBUG
@@ -578,18 +968,139 @@ namespace asx
 #endif
 
 	}
-	string builder::get_building_directory(environment_config& env, const std::string_view& local_target)
-	{
-		return env.registry + ".make";
-	}
-	string builder::get_local_targets_directory(environment_config& env, const std::string_view& name)
-	{
-		return stringify::text("%s%s%cbin", env.registry.c_str(), name.data(), VI_SPLITTER);
-	}
-	string builder::get_global_targets_directory(environment_config& env, const std::string_view& name)
+	string builder::get_global_addons_path()
+	{
+		const char* directory = std::getenv("ASX_ADDONS_CACHE");
+		if (directory != nullptr && *directory != '\0')
+			return directory;
+#if VI_MICROSOFT
+		string cache_directory = *os::directory::get_module();
+		if (cache_directory.back() != '/' && cache_directory.back() != '\\')
+			cache_directory += VI_SPLITTER;
+		cache_directory += ".cache";
+		cache_directory += VI_SPLITTER;
+		cache_directory += "addons";
+		return cache_directory;
+#else
+		return "/var/lib/asx/addons";
+#endif
+	}
+	string builder::get_addon_cache_directory(system_config& config, environment_config& env, const std::string_view& name)
+	{
+		string revision = get_addon_revision(env, name);
+		if (revision.empty())
+			return string();
+
+		/* key only knows the commit, local edits of a checkout must never be served from or stored into shared cache */
+		if (is_addon_dirty(env, name))
+		{
+			VI_DEBUG("%s cache bypass: working tree has local changes", name.data());
+			return string();
+		}
+
+		auto* lib = vitex::runtime::get();
+		string key = revision + ':' + string(lib->get_compiler()) + ':' + string(lib->get_platform()) + ':' + get_build_type(config) + ':' + get_system_version();
+		string path = get_global_addons_path();
+		path += VI_SPLITTER;
+		path.append(name.substr(1));
+		path += VI_SPLITTER;
+		path += code_cache::get_hash(key);
+		return path;
+	}
+	bool builder::is_addon_dirty(environment_config& env, const std::string_view& name)
+	{
+		bool dirty = false;
+		string command = "cd \"" + env.registry + string(name) + "\" && git status --porcelain --untracked-files=normal";
+		auto exit_code = os::process::execute(command, file_mode::read_only, [&dirty](const std::string_view& buffer)
+		{
+			string line = string(buffer);
+			dirty = dirty || !stringify::trim(line).empty();
+			return true;
+		});
+		return dirty || !exit_code || *exit_code != 0;
+	}
+	string builder::get_addon_lock_path(environment_config& env)
+	{
+		string path = env.registry;
+		if (!path.empty() && (path.back() == '/' || path.back() == '\\'))
+			path.erase(path.end() - 1);
+		return os::path::get_directory(path) + "asx.lock";
+	}
+	string builder::get_addon_source(environment_config& env, const std::string_view& name)
+	{
+		string mirror = env.mirror;
+		if (mirror.empty())
+		{
+			const char* directory = std::getenv("ASX_ADDONS_MIRROR");
+			if (directory != nullptr)
+				mirror = directory;
+		}
+
+		if (mirror.empty())
+			return REPOSITORY_SOURCE + string(name.substr(1));
+
+		if (mirror.back() != '/' && mirror.back() != '\\')
+			mirror += VI_SPLITTER;
+		return "\"" + mirror + string(name.substr(1)) + "\"";
+	}
+	string builder::get_addon_hash(environment_config& env, virtual_machine* vm, const std::string_view& name)
+	{
+		if (!is_addon_target_exists(env, vm, name))
+			return string();
+
+		auto data = os::file::read_as_string(get_addon_target_library(env, vm, name, nullptr));
+		return data ? code_cache::get_hash(*data) : string();
+	}
+	string builder::get_addon_revision(environment_config& env, const std::string_view& name)
+	{
+		string git_directory = env.registry + string(name) + VI_SPLITTER + ".git" + VI_SPLITTER;
+		auto head = os::file::read_as_string((git_directory + "HEAD").c_str());
+		if (!head)
+			return string();
+
+		string revision = *head;
+		stringify::trim(revision);
+		if (!stringify::starts_with(revision, "ref: "))
+			return revision;
+
+		string reference = revision.substr(5);
+		auto target = os::file::read_as_string((git_directory + reference).c_str());
+		if (target)
+		{
+			revision = *target;
+			return stringify::trim(revision);
+		}
+
+		auto packed = os::file::read_as_string((git_directory + "packed-refs").c_str());
+		if (!packed)
+			return string();
+
+		for (auto& line : stringify::split(*packed, '\n'))
+		{
+			stringify::trim(line);
+			if (line.size() > reference.size() + 1 && stringify::ends_with(line, " " + reference))
+				return line.substr(0, line.find(' '));
+		}
+
+		return string();
+	}
+	string builder::get_building_directory(environment_config& env, const std::string_view& local_target)
+	{
+		string path = env.registry + ".make";
+		if (local_target.size() > env.registry.size() + 1 && stringify::starts_with(local_target, env.registry))
+		{
+			path += VI_SPLITTER;
+			path.append(local_target.substr(env.registry.size() + 1));
+		}
+		return path;
+	}
+	string builder::get_local_targets_directory(environment_config& env, const std::string_view& name)
+	{
+		return stringify::text("%s%s%cbin", env.registry.c_str(), name.data(), VI_SPLITTER);
+	}
+	string builder::get_global_targets_directory(environment_config& env, const std::string_view& name)
 	{
 		string owner = string(name.substr(0, name.find('/')));
-		string repository = string(os::path::get_filename(name));
 		string path = env.registry + ".bin";
 		path += VI_SPLITTER;
 		path += owner;
@@ -661,13 +1172,26 @@ namespace asx
 			config_settings_array += stringify::text("{ (uint32_t)%i, (size_t)%" PRIu64 " }, ", item.second, (uint64_t)value);
 		}
 
+		vector<string> system_addons;
 		string config_system_addons_array;
 		for (auto& item : vm->get_system_addons())
 		{
-			if (item.second.exposed)
-				config_system_addons_array += stringify::text("\"%s\", ", item.first.c_str());
+			if (!item.second.exposed)
+				continue;
+
+			config_system_addons_array += stringify::text("\"%s\", ", item.first.c_str());
+			system_addons.push_back(item.first);
 		}
 
+		size_t modules = get_init_modules(system_addons, !vm->get_clibraries().empty() || !env.addons.empty());
+		string config_modules = "vitex::use_locale";
+		if (modules & vitex::use_networking)
+			config_modules += " | vitex::use_networking";
+		if (modules & vitex::use_cryptography)
+			config_modules += " | vitex::use_cryptography";
+		if (modules & vitex::use_providers)
+			config_modules += " | vitex::use_providers";
+
 		string config_libraries_array, config_functions_array;
 		for (auto& item : vm->get_clibraries())
 		{
@@ -771,12 +1295,17 @@ namespace asx
 		keys["BUILDER_ENV_AUTO_SCHEDULE"] = to_string(env.auto_schedule);
 		keys["BUILDER_ENV_AUTO_CONSOLE"] = env.auto_console ? "true" : "false";
 		keys["BUILDER_ENV_AUTO_STOP"] = env.auto_stop ? "true" : "false";
+		keys["BUILDER_ENV_GC_PAUSE"] = to_string(env.gc.pause);
+		keys["BUILDER_ENV_GC_GROWTH"] = to_string(env.gc.growth);
+		keys["BUILDER_ENV_GC_INTERVAL"] = to_string(env.gc.interval);
+		keys["BUILDER_ENV_GC_ADAPTIVE"] = env.gc.adaptive ? "true" : "false";
 		keys["BUILDER_CONFIG_INSTALL"] = schema::to_json(config_install_array);
 		keys["BUILDER_CONFIG_PERMISSIONS"] = config_permissions_array;
 		keys["BUILDER_CONFIG_SETTINGS"] = config_settings_array;
 		keys["BUILDER_CONFIG_LIBRARIES"] = config_libraries_array;
 		keys["BUILDER_CONFIG_FUNCTIONS"] = config_functions_array;
 		keys["BUILDER_CONFIG_ADDONS"] = config_system_addons_array;
+		keys["BUILDER_CONFIG_MODULES"] = config_modules;
 		keys["BUILDER_CONFIG_TAGS"] = config.tags ? "true" : "false";
 		keys["BUILDER_CONFIG_TS_IMPORTS"] = config.ts_imports ? "true" : "false";
 		keys["BUILDER_CONFIG_ESSENTIALS_ONLY"] = config.essentials_only ? "true" : "false";
@@ -799,6 +1328,902 @@ namespace asx
 		return it != config.permissions.end() ? it->second : os::control::has(option);
 	}
 
+	bool code_cache::load(system_config& config, environment_config& env, virtual_machine* vm, compiler* unit, const unordered_map<string, uint32_t>& settings)
+	{
+		string path = get_directory(env) + get_key(config, env, vm, settings);
+		auto manifest_data = os::file::read_as_string(path + ".json");
+		if (!manifest_data)
+			return false;
+
+		auto manifest_result = schema::from_json(*manifest_data);
+		if (!manifest_result)
+			return false;
+
+		uptr<schema> manifest = *manifest_result;
+		schema* includes = manifest->get("includes");
+		if (!is_unchanged(includes))
+		{
+			VI_DEBUG("%s cache miss: includes have changed", env.library);
+			return false;
+		}
+
+		schema* system_addons = manifest->get("system_addons");
+		if (system_addons != nullptr)
+		{
+			for (auto* item : system_addons->get_childs())
+			{
+				if (!vm->import_system_addon(item->value.get_blob()))
+					return false;
+			}
+		}
+
+		schema* libraries = manifest->get("libraries");
+		if (libraries != nullptr)
+		{
+			auto& imports = vm->get_clibraries();
+			for (auto* item : libraries->get_childs())
+			{
+				string library_path = item->get_var("path").get_blob();
+				if (imports.find(library_path) == imports.end() && !vm->import_clibrary(library_path, item->get_var("addon").get_boolean()))
+					return false;
+			}
+		}
+
+		schema* addons = manifest->get("addons");
+		if (addons != nullptr)
+		{
+			for (auto* item : addons->get_childs())
+			{
+				string name = item->value.get_blob(), output;
+				if (builder::import_into_addon(env, vm, name, output) != status_code::OK)
+					return false;
+			}
+		}
+
+		byte_code_info info;
+		if (!builder::read_byte_code(path + ".bin", &info))
+			return false;
+
+		runtime::configure_system(config);
+		if (!unit->load_byte_code(&info).get())
+		{
+			VI_DEBUG("%s cache miss: bytecode cannot be loaded", env.library);
+			return false;
+		}
+
+		/* environment is only updated once bytecode is loaded, a miss leaves it as it was */
+		if (addons != nullptr)
+		{
+			for (auto* item : addons->get_childs())
+				env.addons.insert(item->value.get_blob());
+		}
+
+		if (includes != nullptr)
+		{
+			for (auto* item : includes->get_childs())
+				env.includes.insert(item->get_var("path").get_blob());
+		}
+
+		schema* environment = manifest->get("environment");
+		if (environment != nullptr)
+		{
+			env.auto_schedule = (int32_t)environment->get_var("auto_schedule").get_integer();
+			env.auto_console = environment->get_var("auto_console").get_boolean();
+			env.auto_stop = environment->get_var("auto_stop").get_boolean();
+		}
+
+		if (environment != nullptr && environment->has("gc_pause"))
+		{
+			env.gc.pause = (uint64_t)environment->get_var("gc_pause").get_integer();
+			env.gc.growth = (uint64_t)environment->get_var("gc_growth").get_integer();
+			env.gc.interval = (uint64_t)environment->get_var("gc_interval").get_integer();
+			env.gc.adaptive = environment->get_var("gc_adaptive").get_boolean();
+		}
+
+		return true;
+	}
+	bool code_cache::store(system_config& config, environment_config& env, virtual_machine* vm, compiler* unit, const unordered_map<string, uint32_t>& settings)
+	{
+		for (auto& item : vm->get_clibraries())
+		{
+			if (!item.second.is_addon && !item.second.functions.empty() && config.functions.find(item.first) == config.functions.end())
+				return false;
+		}
+
+		byte_code_info info;
+		info.debug = false;
+		if (!unit->save_byte_code(&info))
+			return false;
+
+		schema* includes = get_includes(env, vm);
+		if (!includes)
+			return false;
+
+		uptr<schema> manifest = var::set::object();
+		manifest->set("includes", includes);
+		schema* addons = manifest->set("addons", var::set::array());
+		for (auto& item : env.addons)
+			addons->push(var::string(item));
+
+		schema* system_addons = manifest->set("system_addons", var::set::array());
+		for (auto& item : vm->get_system_addons())
+		{
+			if (item.second.exposed)
+				system_addons->push(var::string(item.first));
+		}
+
+		schema* libraries = manifest->set("libraries", var::set::array());
+		for (auto& item : vm->get_clibraries())
+		{
+			schema* library = libraries->push(var::set::object());
+			library->set("path", var::string(item.first));
+			library->set("addon", var::boolean(item.second.is_addon));
+		}
+
+		schema* environment = manifest->set("environment", var::set::object());
+		environment->set("auto_schedule", var::integer(env.auto_schedule));
+		environment->set("auto_console", var::boolean(env.auto_console));
+		environment->set("auto_stop", var::boolean(env.auto_stop));
+		environment->set("gc_pause", var::integer((int64_t)env.gc.pause));
+		environment->set("gc_growth", var::integer((int64_t)env.gc.growth));
+		environment->set("gc_interval", var::integer((int64_t)env.gc.interval));
+		environment->set("gc_adaptive", var::boolean(env.gc.adaptive));
+
+		string directory = get_directory(env);
+		if (!os::directory::patch(directory))
+			return false;
+
+		/* manifest is renamed into place last, entry is never visible without its bytecode */
+		string path = directory + get_key(config, env, vm, settings);
+		string data = schema::to_json(*manifest);
+		if (!write_file_atomic(path + ".bin", (uint8_t*)info.data.data(), info.data.size()) || !write_file_atomic(path + ".json", (uint8_t*)data.data(), data.size()))
+		{
+			VI_DEBUG("%s cache error: write failed", env.library);
+			return false;
+		}
+
+		prune(directory);
+		return store_graph(env, vm, includes);
+	}
+	void code_cache::prune(const std::string_view& directory)
+	{
+		vector<std::pair<string, file_entry>> entries;
+		if (!os::directory::scan(string(directory).c_str(), entries))
+			return;
+
+		vector<std::pair<int64_t, string>> manifests;
+		for (auto& item : entries)
+		{
+			if (item.second.is_directory)
+				continue;
+			else if (stringify::ends_with(item.first, ".json"))
+				manifests.push_back(std::make_pair((int64_t)item.second.last_modified, item.first.substr(0, item.first.size() - 5)));
+			else if (stringify::ends_with(item.first, ".as.gz"))
+				os::file::remove((string(directory) + item.first).c_str());
+		}
+
+		if (manifests.size() <= max_entries)
+			return;
+
+		/* every source change produces a new key, oldest entries are dropped so that cache stays bounded */
+		std::sort(manifests.begin(), manifests.end());
+		for (size_t i = 0; i < manifests.size() - max_entries; i++)
+		{
+			string path = string(directory) + manifests[i].second;
+			os::file::remove((path + ".json").c_str());
+			os::file::remove((path + ".bin").c_str());
+		}
+	}
+	bool code_cache::store_graph(environment_config& env, virtual_machine* vm, schema* includes)
+	{
+		schema* graph_includes = includes ? includes->copy() : get_includes(env, vm);
+		if (!graph_includes)
+			return false;
+
+		uptr<schema> graph = var::set::object();
+		graph->set("includes", graph_includes);
+		if (!append_include(graph_includes, env.path))
+			return false;
+
+		vector<string> exposed_addons;
+		for (auto& item : vm->get_system_addons())
+		{
+			if (item.second.exposed)
+				exposed_addons.push_back(item.first);
+		}
+
+		schema* exposes = graph->set("exposes", var::set::array());
+		for (auto& item : vm->get_exposed_addons())
+			exposes->push(var::string(item));
+
+		schema* addons = graph->set("addons", var::set::array());
+		for (auto& item : env.addons)
+		{
+			schema* addon = addons->push(var::set::object());
+			addon->set("name", var::string(item));
+			addon->set("library", var::string(builder::get_addon_target_library(env, vm, item, nullptr)));
+		}
+
+		graph->set("modules", var::integer((int64_t)builder::get_init_modules(exposed_addons, !vm->get_clibraries().empty() || !env.addons.empty())));
+		string directory = get_directory(env);
+		string data = schema::to_json(*graph);
+		return os::directory::patch(directory) && write_file_atomic(directory + get_hash(env.path) + ".modules", (uint8_t*)data.data(), data.size());
+	}
+	bool code_cache::append_include(schema* includes, const std::string_view& path)
+	{
+		file_entry state;
+		auto data = os::file::read_as_string(path);
+		if (!data || !os::file::get_state(path, &state))
+			return false;
+
+		schema* include = includes->push(var::set::object());
+		include->set("path", var::string(path));
+		include->set("hash", var::string(get_hash(*data)));
+		include->set("size", var::integer((int64_t)state.size));
+		include->set("time", var::integer((int64_t)state.last_modified));
+		return true;
+	}
+	bool code_cache::is_unchanged(schema* includes)
+	{
+		if (!includes)
+			return true;
+
+		for (auto* item : includes->get_childs())
+		{
+			file_entry state;
+			string path = item->get_var("path").get_blob();
+			if (item->has("time") && os::file::get_state(path, &state) && !state.is_directory && (int64_t)state.size == item->get_var("size").get_integer() && (int64_t)state.last_modified == item->get_var("time").get_integer())
+				continue;
+
+			auto data = os::file::read_as_string(path);
+			if (!data || get_hash(*data) != item->get_var("hash").get_blob())
+				return false;
+		}
+
+		return true;
+	}
+	size_t code_cache::get_init_modules(const std::string_view& registry, const std::string_view& path, size_t modules)
+	{
+		uptr<schema> graph = get_graph(registry, path);
+		if (!graph || !graph->has("modules"))
+			return modules;
+
+		return (size_t)graph->get_var("modules").get_integer();
+	}
+	schema* code_cache::get_graph(const std::string_view& registry, const std::string_view& path)
+	{
+		auto data = os::file::read_as_string(string(registry) + ".cache" + VI_SPLITTER + get_hash(path) + ".modules");
+		if (!data)
+			return nullptr;
+
+		auto result = schema::from_json(*data);
+		if (!result)
+			return nullptr;
+
+		schema* graph = *result;
+		if (is_unchanged(graph->get("includes")))
+			return graph;
+
+		memory::release(graph);
+		return nullptr;
+	}
+	schema* code_cache::get_includes(environment_config& env, virtual_machine* vm)
+	{
+		unordered_set<string> dependencies = env.includes;
+		for (auto& item : env.addons)
+			dependencies.insert(builder::get_addon_target_library(env, vm, item, nullptr));
+
+		schema* includes = var::set::array();
+		for (auto& item : dependencies)
+		{
+			if (!append_include(includes, item))
+			{
+				memory::release(includes);
+				return nullptr;
+			}
+		}
+
+		return includes;
+	}
+	string code_cache::get_key(system_config& config, environment_config& env, virtual_machine* vm, const unordered_map<string, uint32_t>& settings)
+	{
+		vector<string> properties;
+		properties.reserve(settings.size());
+		for (auto& item : settings)
+			properties.push_back(item.first + "=" + to_string(vm->get_property((features)item.second)));
+		std::sort(properties.begin(), properties.end());
+
+		string key = builder::get_system_version();
+		key += '\n' + to_string(sizeof(void*));
+		key += '\n' + env.path;
+		for (auto& item : properties)
+			key += '\n' + item;
+		for (auto& item : config.system_addons)
+			key += "\naddon:" + item;
+		for (auto& item : config.libraries)
+			key += "\nlibrary:" + item.first + (item.second ? "+" : "-");
+		for (auto& item : config.functions)
+			key += "\nfunction:" + item.first + ":" + item.second.first + "=" + item.second.second;
+		key += config.ts_imports ? "\nts_imports" : "";
+		key += config.tags ? "\ntags" : "";
+		key += config.save_source_code ? "\nsave_source_code" : "";
+		key += '\n' + env.program;
+		return get_hash(key);
+	}
+	string code_cache::get_directory(environment_config& env)
+	{
+		return env.registry + ".cache" + VI_SPLITTER;
+	}
+	string code_cache::get_hash(const std::string_view& data)
+	{
+		uint64_t hash = 14695981039346656037ull;
+		for (char item : data)
+		{
+			hash ^= (uint8_t)item;
+			hash *= 1099511628211ull;
+		}
+		return stringify::text("%016" PRIx64, hash);
+	}
+
+	bool benchmark::execute(environment_config& env, virtual_machine* vm, immediate_context* context, compiler* unit)
+	{
+		if (env.benchmarks.empty())
+		{
+			VI_ERR("%s bench error: no functions with #[bench] tag", env.library);
+			return false;
+		}
+
+		uptr<schema> baseline;
+		if (!env.bench_baseline.empty())
+		{
+			auto data = os::file::read_as_string(env.bench_baseline);
+			if (!data)
+			{
+				VI_ERR("%s bench error: cannot read baseline", env.bench_baseline.c_str());
+				return false;
+			}
+
+			auto result = schema::from_json(*data);
+			if (!result)
+			{
+				VI_ERR("%s bench error: invalid baseline", env.bench_baseline.c_str());
+				return false;
+			}
+			baseline = *result;
+		}
+
+		auto* terminal = console::get();
+		uptr<schema> report = var::set::object();
+		report->set("version", var::string(builder::get_system_version()));
+		report->set("script", var::string(env.path));
+		schema* results = report->set("benchmarks", var::set::array());
+		for (auto& target : env.benchmarks)
+		{
+			schema* result = execute_target(target, vm, context, unit);
+			if (!result)
+				return false;
+
+			results->push(result);
+			string line = "  " + target.name + ": " + get_summary(result);
+			schema* previous = baseline ? baseline->get("benchmarks") : nullptr;
+			if (previous != nullptr)
+			{
+				for (auto* item : previous->get_childs())
+				{
+					if (item->get_var("name").get_blob() != target.name)
+						continue;
+
+					double before = item->get_var("median_ns").get_number();
+					double after = result->get_var("median_ns").get_number();
+					if (before > 0.0)
+						line += stringify::text(" [%+.1f%% vs baseline]", (after - before) * 100.0 / before);
+					break;
+				}
+			}
+			terminal->write_line(line);
+		}
+
+		if (env.bench_output.empty())
+			return true;
+
+		string data = schema::to_json(*report);
+		if (!os::file::write(env.bench_output, (uint8_t*)data.data(), data.size()))
+		{
+			VI_ERR("%s bench error: write failed", env.bench_output.c_str());
+			return false;
+		}
+
+		return true;
+	}
+	bool benchmark::execute_expression(virtual_machine* vm, immediate_context* context, compiler* unit, const std::string_view& expression, bool repeat)
+	{
+		string code = string(expression);
+		stringify::trim(code);
+		if (code.empty())
+		{
+			VI_ERR("bench error: expression is empty");
+			return false;
+		}
+		else if (code.back() != ';')
+			code += ';';
+
+		auto entry = unit->compile_function(code, "void").get();
+		if (!entry)
+			return false;
+
+		uptr<schema> single = execute_function(expression, *entry, 0, 1, vm, context);
+		if (!single)
+			return false;
+
+		auto* terminal = console::get();
+		if (!repeat)
+		{
+			string line = "  time " + get_duration(single->get_var("min_ns").get_number());
+			line += ", " + stringify::text("%.0f", single->get_var("gc_objects_per_op").get_number()) + " gc objects";
+			line += ", " + stringify::text("%.0f", single->get_var("retained_bytes_per_op").get_number()) + " retained heap bytes";
+			terminal->write_line(line);
+			return true;
+		}
+
+		/* aim for roughly one second of measurements based on the first run */
+		double nanoseconds = std::max(1.0, single->get_var("min_ns").get_number());
+		size_t iterations = (size_t)std::min(1000000.0, std::max(10.0, 1000000000.0 / nanoseconds));
+		uptr<schema> result = execute_function(expression, *entry, std::max<size_t>(1, iterations / 10), iterations, vm, context);
+		if (!result)
+			return false;
+
+		terminal->write_line("  " + to_string(iterations) + " runs: " + get_summary(*result));
+		return true;
+	}
+	schema* benchmark::execute_target(benchmark_target& target, virtual_machine* vm, immediate_context* context, compiler* unit)
+	{
+		function entry = unit->get_module().get_function_by_name(target.name);
+		if (!entry.is_valid() || entry.get_args_count() > 0)
+		{
+			VI_ERR("%s bench error: function must exist and take no arguments", target.name.c_str());
+			return nullptr;
+		}
+
+		schema* result = execute_function(target.name, entry, target.warmup, target.iterations, vm, context);
+		if (result != nullptr)
+			result->set("warmup", var::integer((int64_t)target.warmup));
+		return result;
+	}
+	schema* benchmark::execute_function(const std::string_view& name, function& entry, size_t warmup, size_t iterations, virtual_machine* vm, immediate_context* context)
+	{
+		for (size_t i = 0; i < warmup; i++)
+		{
+			if (!execute_call(context, entry))
+				return nullptr;
+		}
+
+		auto* engine = vm->get_engine();
+		asUINT size = 0, destroyed = 0, new_destroyed = 0;
+		engine->GetGCStatistics(&size, &destroyed, nullptr, nullptr, &new_destroyed);
+		int64_t gc_objects = -(int64_t)(size + destroyed + new_destroyed);
+		int64_t retained_bytes = -startup_profiler::get_retained_bytes();
+
+		vector<int64_t> timings;
+		timings.reserve(std::max<size_t>(1, iterations));
+		for (size_t i = 0; i < std::max<size_t>(1, iterations); i++)
+		{
+			auto time = std::chrono::steady_clock::now();
+			if (!execute_call(context, entry))
+				return nullptr;
+			timings.push_back((int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time).count());
+		}
+
+		engine->GetGCStatistics(&size, &destroyed, nullptr, nullptr, &new_destroyed);
+		gc_objects += (int64_t)(size + destroyed + new_destroyed);
+		retained_bytes += startup_profiler::get_retained_bytes();
+
+		double total = 0.0;
+		for (auto& item : timings)
+			total += (double)item;
+		std::sort(timings.begin(), timings.end());
+
+		double count = (double)timings.size();
+		double mean = total / count;
+		schema* result = var::set::object();
+		result->set("name", var::string(name));
+		result->set("iterations", var::integer((int64_t)timings.size()));
+		result->set("min_ns", var::number((double)timings.front()));
+		result->set("median_ns", var::number((double)timings[timings.size() / 2]));
+		result->set("p99_ns", var::number((double)timings[std::min(timings.size() - 1, (size_t)(count * 0.99))]));
+		result->set("mean_ns", var::number(mean));
+		result->set("ops_per_second", var::number(mean > 0.0 ? 1000000000.0 / mean : 0.0));
+		result->set("gc_objects_per_op", var::number((double)gc_objects / count));
+		result->set("retained_bytes_per_op", var::number((double)retained_bytes / count));
+		return result;
+	}
+	bool benchmark::execute_call(immediate_context* context, function& target)
+	{
+		auto execution = context->execute_call(target, nullptr).get();
+		bool finished = execution && *execution == execution::finished;
+		if (!finished)
+			context->abort();
+		context->unprepare();
+		return finished;
+	}
+	string benchmark::get_summary(schema* result)
+	{
+		string line = "min " + get_duration(result->get_var("min_ns").get_number());
+		line += ", median " + get_duration(result->get_var("median_ns").get_number());
+		line += ", p99 " + get_duration(result->get_var("p99_ns").get_number());
+		line += ", " + stringify::text("%.0f", result->get_var("ops_per_second").get_number()) + " ops/sec";
+		line += ", " + stringify::text("%.2f", result->get_var("gc_objects_per_op").get_number()) + " gc objects/op";
+		line += ", " + stringify::text("%.0f", result->get_var("retained_bytes_per_op").get_number()) + " retained heap bytes/op";
+		return line;
+	}
+	string benchmark::get_duration(double nanoseconds)
+	{
+		if (nanoseconds >= 1000000000.0)
+			return stringify::text("%.3fs", nanoseconds / 1000000000.0);
+		else if (nanoseconds >= 1000000.0)
+			return stringify::text("%.3fms", nanoseconds / 1000000.0);
+		else if (nanoseconds >= 1000.0)
+			return stringify::text("%.3fus", nanoseconds / 1000.0);
+		return stringify::text("%.0fns", nanoseconds);
+	}
+
+	size_t aot_translator::translate(compiler* unit, string& output)
+	{
+		asIScriptModule* module = unit->get_module().get_module();
+		if (!module)
+			return 0;
+
+		string functions, table;
+		size_t count = 0;
+		asIScriptEngine* engine = module->GetEngine();
+		int last_id = (int)engine->GetLastFunctionId();
+		for (int i = 0; i <= last_id; i++)
+		{
+			asIScriptFunction* function = engine->GetFunctionById(i);
+			if (function != nullptr && function->GetFuncType() == asFUNC_SCRIPT && function->GetModule() == module && translate_function(function, count, functions, table))
+				++count;
+		}
+
+		if (!count)
+			return 0;
+
+		output = "#include \"runtime.hpp\"\n#include <cmath>\n\nusing namespace asx;\n\n" + functions;
+		output += "extern const aot_function program_aot_functions[] =\n{\n" + table + "};\n";
+		output += "extern const size_t program_aot_functions_count = " + to_string(count) + ";\n";
+		return count;
+	}
+	bool aot_translator::translate_function(asIScriptFunction* function, size_t index, string& output, string& table)
+	{
+		asUINT length = 0;
+		asDWORD* byte_code = function->GetByteCode(&length);
+		if (!byte_code || !length)
+			return false;
+
+		vector<std::pair<asUINT, string>> instructions;
+		unordered_set<asUINT> offsets, labels;
+		for (asUINT offset = 0; offset < length;)
+		{
+			asBYTE op = *(asBYTE*)(byte_code + offset);
+			int size = asBCTypeSize[asBCInfo[op].type];
+			if (size <= 0 || offset + (asUINT)size > length)
+				return false;
+
+			switch (op)
+			{
+				case asBC_JMP:
+				case asBC_JZ:
+				case asBC_JNZ:
+				case asBC_JS:
+				case asBC_JNS:
+				case asBC_JP:
+				case asBC_JNP:
+				case asBC_JLowZ:
+				case asBC_JLowNZ:
+					labels.insert(offset + (asUINT)size + (asUINT)*(int*)(byte_code + offset + 1));
+					break;
+				default:
+					break;
+			}
+
+			instructions.emplace_back(offset, translate_instruction(byte_code + offset, offset, (asUINT)size));
+			offsets.insert(offset);
+			offset += (asUINT)size;
+		}
+
+		for (auto& label : labels)
+		{
+			if (!offsets.count(label))
+				return false;
+		}
+
+		/* resume only at jit entries that are followed by translated code, others stay interpreted */
+		string name = "aot_function_" + to_string(index);
+		string entries, cases;
+		asUINT entries_count = 0;
+		for (size_t i = 0; i + 1 < instructions.size(); i++)
+		{
+			asUINT offset = instructions[i].first;
+			if (*(asBYTE*)(byte_code + offset) != asBC_JitEntry || instructions[i + 1].second.empty())
+				continue;
+
+			labels.insert(offset);
+			entries += to_string(offset) + ", ";
+			cases += stringify::text("\t\tcase %u:\n\t\t\tbc = registers->programPointer - %u;\n\t\t\tgoto l_%u;\n", ++entries_count, offset, offset);
+		}
+
+		if (!entries_count)
+			return false;
+
+		output += "static void " + name + "(asSVMRegisters* registers, asPWORD entry)\n{\n";
+		output += "\tasDWORD* bc = nullptr;\n\tasDWORD* fp = registers->stackFramePointer;\n\tasQWORD value = registers->valueRegister;\n";
+		output += "\tswitch (entry)\n\t{\n" + cases + "\t\tdefault:\n\t\t\tregisters->programPointer += 1 + AS_PTR_SIZE;\n\t\t\treturn;\n\t}\n";
+		for (auto& item : instructions)
+		{
+			if (labels.count(item.first) > 0)
+				output += "l_" + to_string(item.first) + ":\n";
+			output += "\t" + (item.second.empty() ? get_exit(item.first) : item.second) + "\n";
+		}
+		output += "}\n";
+		output += "static const asUINT " + name + "_entries[] = { " + entries + "};\n\n";
+
+		string declaration = function->GetDeclaration(true, true, false);
+		stringify::replace(declaration, "\\", "\\\\");
+		stringify::replace(declaration, "\"", "\\\"");
+		table += stringify::text("\t{ \"%s\", 0x%" PRIx64 "ull, %u, &%s, %s_entries, %u },\n", declaration.c_str(), aot_function::get_hash(byte_code, length), length, name.c_str(), name.c_str(), entries_count);
+		return true;
+	}
+	string aot_translator::translate_instruction(const asDWORD* byte_code, asUINT offset, asUINT size)
+	{
+		struct conversion
+		{
+			asEBCInstr op;
+			const char* to;
+			const char* from;
+		};
+		static const conversion conversions[] =
+		{
+			{ asBC_iTOf, "float", "int" }, { asBC_fTOi, "int", "float" }, { asBC_uTOf, "float", "asUINT" },
+			{ asBC_sbTOi, "int", "signed char" }, { asBC_swTOi, "int", "short" }, { asBC_ubTOi, "asDWORD", "asBYTE" }, { asBC_uwTOi, "asDWORD", "asWORD" },
+			{ asBC_dTOi, "int", "double" }, { asBC_dTOf, "float", "double" }, { asBC_iTOd, "double", "int" }, { asBC_uTOd, "double", "asUINT" }, { asBC_fTOd, "double", "float" },
+			{ asBC_i64TOi, "int", "asINT64" }, { asBC_uTOi64, "asINT64", "asUINT" }, { asBC_iTOi64, "asINT64", "int" }, { asBC_fTOi64, "asINT64", "float" },
+			{ asBC_dTOi64, "asINT64", "double" }, { asBC_i64TOf, "float", "asINT64" }, { asBC_i64TOd, "double", "asINT64" }
+		};
+
+		asEBCInstr op = (asEBCInstr)*(const asBYTE*)byte_code;
+		if (!aot_function::is_translated((asBYTE)op))
+			return string();
+
+		int a = *(((const short*)byte_code) + 1);
+		int b = *(((const short*)byte_code) + 2);
+		int c = *(((const short*)byte_code) + 3);
+		asDWORD argument = *(byte_code + 1);
+		asUINT target = offset + size + (asUINT)(int)argument;
+		auto var = [](const char* type, int index) -> string
+		{
+			return stringify::text("*(%s*)(fp - %i)", type, index);
+		};
+		auto binary = [&](const char* type, const char* operation) -> string
+		{
+			return var(type, a) + " = " + var(type, b) + " " + operation + " " + var(type, c) + ";";
+		};
+		auto immediate = [&](const char* type, const char* operation) -> string
+		{
+			string constant = strcmp(type, "float") ? stringify::text("0x%xu", *(byte_code + 2)) : stringify::text("aot_function::to_float(0x%xu)", *(byte_code + 2));
+			return var(type, a) + " = " + var(type, b) + " " + operation + " " + constant + ";";
+		};
+		auto compare = [](const char* type, const string& left, const string& right) -> string
+		{
+			return stringify::text("{ %s left = %s, right = %s; *(int*)&value = left == right ? 0 : (left < right ? -1 : 1); }", type, left.c_str(), right.c_str());
+		};
+		auto division = [&](const char* type, const string& expression, const char* overflow) -> string
+		{
+			/* faulting divisions leave the vm to raise its own exception */
+			string condition = var(type, c) + " == 0";
+			if (overflow != nullptr)
+				condition += " || (" + var(type, c) + " == -1 && " + var(type, b) + " == " + overflow + ")";
+			return "if (" + condition + ") " + get_exit(offset) + " else " + var(type, a) + " = " + expression + ";";
+		};
+		auto jump = [&](const char* condition) -> string
+		{
+			return stringify::text("if (%s) goto l_%u;", condition, target);
+		};
+
+		switch (op)
+		{
+			case asBC_JitEntry:
+				return ";";
+			case asBC_SUSPEND:
+				return "if (registers->doProcessSuspend) " + get_exit(offset);
+			case asBC_SetV1:
+			case asBC_SetV2:
+			case asBC_SetV4:
+				return var("asDWORD", a) + stringify::text(" = 0x%xu;", argument);
+			case asBC_SetV8:
+				return var("asQWORD", a) + stringify::text(" = 0x%" PRIx64 "ull;", *(const asQWORD*)(byte_code + 1));
+			case asBC_CpyVtoV4:
+				return var("asDWORD", a) + " = " + var("asDWORD", b) + ";";
+			case asBC_CpyVtoV8:
+				return var("asQWORD", a) + " = " + var("asQWORD", b) + ";";
+			case asBC_CpyVtoR4:
+				return "*(asDWORD*)&value = " + var("asDWORD", a) + ";";
+			case asBC_CpyVtoR8:
+				return "value = " + var("asQWORD", a) + ";";
+			case asBC_CpyRtoV4:
+				return var("asDWORD", a) + " = *(asDWORD*)&value;";
+			case asBC_CpyRtoV8:
+				return var("asQWORD", a) + " = value;";
+			case asBC_ClrHi:
+				return "*(asDWORD*)&value &= 0xFF;";
+			case asBC_CMPi:
+				return compare("int", var("int", a), var("int", b));
+			case asBC_CMPu:
+				return compare("asDWORD", var("asDWORD", a), var("asDWORD", b));
+			case asBC_CMPf:
+				return compare("float", var("float", a), var("float", b));
+			case asBC_CMPd:
+				return compare("double", var("double", a), var("double", b));
+			case asBC_CMPi64:
+				return compare("asINT64", var("asINT64", a), var("asINT64", b));
+			case asBC_CMPu64:
+				return compare("asQWORD", var("asQWORD", a), var("asQWORD", b));
+			case asBC_CMPIi:
+				return compare("int", var("int", a), stringify::text("(int)0x%xu", argument));
+			case asBC_CMPIu:
+				return compare("asDWORD", var("asDWORD", a), stringify::text("0x%xu", argument));
+			case asBC_CMPIf:
+				return compare("float", var("float", a), stringify::text("aot_function::to_float(0x%xu)", argument));
+			case asBC_TZ:
+				return "value = *(int*)&value == 0 ? 1 : 0;";
+			case asBC_TNZ:
+				return "value = *(int*)&value != 0 ? 1 : 0;";
+			case asBC_TS:
+				return "value = *(int*)&value < 0 ? 1 : 0;";
+			case asBC_TNS:
+				return "value = *(int*)&value >= 0 ? 1 : 0;";
+			case asBC_TP:
+				return "value = *(int*)&value > 0 ? 1 : 0;";
+			case asBC_TNP:
+				return "value = *(int*)&value <= 0 ? 1 : 0;";
+			case asBC_JMP:
+				return stringify::text("goto l_%u;", target);
+			case asBC_JZ:
+				return jump("*(int*)&value == 0");
+			case asBC_JNZ:
+				return jump("*(int*)&value != 0");
+			case asBC_JS:
+				return jump("*(int*)&value < 0");
+			case asBC_JNS:
+				return jump("*(int*)&value >= 0");
+			case asBC_JP:
+				return jump("*(int*)&value > 0");
+			case asBC_JNP:
+				return jump("*(int*)&value <= 0");
+			case asBC_JLowZ:
+				return jump("*(asBYTE*)&value == 0");
+			case asBC_JLowNZ:
+				return jump("*(asBYTE*)&value != 0");
+			case asBC_ADDi:
+				return binary("asDWORD", "+");
+			case asBC_SUBi:
+				return binary("asDWORD", "-");
+			case asBC_MULi:
+				return binary("asDWORD", "*");
+			case asBC_DIVi:
+				return division("int", var("int", b) + " / " + var("int", c), "(int)0x80000000u");
+			case asBC_MODi:
+				return division("int", var("int", b) + " % " + var("int", c), "(int)0x80000000u");
+			case asBC_DIVu:
+				return division("asDWORD", var("asDWORD", b) + " / " + var("asDWORD", c), nullptr);
+			case asBC_MODu:
+				return division("asDWORD", var("asDWORD", b) + " % " + var("asDWORD", c), nullptr);
+			case asBC_ADDi64:
+				return binary("asQWORD", "+");
+			case asBC_SUBi64:
+				return binary("asQWORD", "-");
+			case asBC_MULi64:
+				return binary("asQWORD", "*");
+			case asBC_DIVi64:
+				return division("asINT64", var("asINT64", b) + " / " + var("asINT64", c), "(asINT64)0x8000000000000000ull");
+			case asBC_MODi64:
+				return division("asINT64", var("asINT64", b) + " % " + var("asINT64", c), "(asINT64)0x8000000000000000ull");
+			case asBC_DIVu64:
+				return division("asQWORD", var("asQWORD", b) + " / " + var("asQWORD", c), nullptr);
+			case asBC_MODu64:
+				return division("asQWORD", var("asQWORD", b) + " % " + var("asQWORD", c), nullptr);
+			case asBC_ADDf:
+				return binary("float", "+");
+			case asBC_SUBf:
+				return binary("float", "-");
+			case asBC_MULf:
+				return binary("float", "*");
+			case asBC_DIVf:
+				return division("float", var("float", b) + " / " + var("float", c), nullptr);
+			case asBC_MODf:
+				return division("float", "std::fmod(" + var("float", b) + ", " + var("float", c) + ")", nullptr);
+			case asBC_ADDd:
+				return binary("double", "+");
+			case asBC_SUBd:
+				return binary("double", "-");
+			case asBC_MULd:
+				return binary("double", "*");
+			case asBC_DIVd:
+				return division("double", var("double", b) + " / " + var("double", c), nullptr);
+			case asBC_MODd:
+				return division("double", "std::fmod(" + var("double", b) + ", " + var("double", c) + ")", nullptr);
+			case asBC_ADDIi:
+				return immediate("asDWORD", "+");
+			case asBC_SUBIi:
+				return immediate("asDWORD", "-");
+			case asBC_MULIi:
+				return immediate("asDWORD", "*");
+			case asBC_ADDIf:
+				return immediate("float", "+");
+			case asBC_SUBIf:
+				return immediate("float", "-");
+			case asBC_MULIf:
+				return immediate("float", "*");
+			case asBC_INCVi:
+				return "++" + var("asDWORD", a) + ";";
+			case asBC_DECVi:
+				return "--" + var("asDWORD", a) + ";";
+			case asBC_NEGi:
+				return var("asDWORD", a) + " = 0u - " + var("asDWORD", a) + ";";
+			case asBC_NEGi64:
+				return var("asQWORD", a) + " = 0ull - " + var("asQWORD", a) + ";";
+			case asBC_NEGf:
+				return var("float", a) + " = -" + var("float", a) + ";";
+			case asBC_NEGd:
+				return var("double", a) + " = -" + var("double", a) + ";";
+			case asBC_BNOT:
+				return var("asDWORD", a) + " = ~" + var("asDWORD", a) + ";";
+			case asBC_BNOT64:
+				return var("asQWORD", a) + " = ~" + var("asQWORD", a) + ";";
+			case asBC_BAND:
+				return binary("asDWORD", "&");
+			case asBC_BOR:
+				return binary("asDWORD", "|");
+			case asBC_BXOR:
+				return binary("asDWORD", "^");
+			case asBC_BAND64:
+				return binary("asQWORD", "&");
+			case asBC_BOR64:
+				return binary("asQWORD", "|");
+			case asBC_BXOR64:
+				return binary("asQWORD", "^");
+			case asBC_BSLL:
+				return binary("asDWORD", "<<");
+			case asBC_BSRL:
+				return binary("asDWORD", ">>");
+			case asBC_BSRA:
+				return var("asDWORD", a) + " = (asDWORD)(" + var("int", b) + " >> " + var("asDWORD", c) + ");";
+			case asBC_BSLL64:
+				return var("asQWORD", a) + " = " + var("asQWORD", b) + " << " + var("asDWORD", c) + ";";
+			case asBC_BSRL64:
+				return var("asQWORD", a) + " = " + var("asQWORD", b) + " >> " + var("asDWORD", c) + ";";
+			case asBC_BSRA64:
+				return var("asQWORD", a) + " = (asQWORD)(" + var("asINT64", b) + " >> " + var("asDWORD", c) + ");";
+			default:
+				break;
+		}
+
+		for (auto& item : conversions)
+		{
+			if (item.op != op)
+				continue;
+
+			auto type = asBCInfo[op].type;
+			if (type != asBCTYPE_rW_ARG && type != asBCTYPE_wW_rW_ARG)
+				return string();
+
+			return var(item.to, a) + " = (" + item.to + ")" + var(item.from, type == asBCTYPE_rW_ARG ? a : b) + ";";
+		}
+
+		return string();
+	}
+	string aot_translator::get_exit(asUINT offset)
+	{
+		return stringify::text("{ registers->programPointer = bc + %u; registers->valueRegister = value; return; }", offset);
+	}
+
 	option<string> templates::fetch(const unordered_map<string, string>& keys, const std::string_view& path)
 	{
 		if (!files)
@@ -20,27 +20,49 @@ namespace asx
 	class builder
 	{
 	public:
-		static status_code compile_into_addon(system_config& config, environment_config& env, virtual_machine* vm, const std::string_view& name, string& output);
+		static status_code fetch_into_addon(system_config& config, environment_config& env, const std::string_view& name, string& output);
+		static status_code compile_into_addons(system_config& config, environment_config& env, virtual_machine* vm);
 		static status_code import_into_addon(environment_config& env, virtual_machine* vm, const std::string_view& name, string& output);
 		static status_code initialize_into_addon(system_config& config, environment_config& env, virtual_machine* vm, const unordered_map<string, uint32_t>& settings);
 		static status_code pull_addon_repository(system_config& config, environment_config& env);
 		static status_code compile_into_executable(system_config& config, environment_config& env, virtual_machine* vm, const unordered_map<string, uint32_t>& settings);
 		static unordered_map<string, uint32_t> get_default_settings();
+		static size_t get_init_modules(const vector<string>& system_addons, bool native_imports);
 		static string get_system_version();
 		static string get_addon_target_library(environment_config& env, virtual_machine* vm, const std::string_view& name, bool* is_vm);
+		static bool load_addon_lock(environment_config& env);
+		static bool store_addon_lock(environment_config& env, virtual_machine* vm);
+		static bool is_addon_locked(environment_config& env, virtual_machine* vm, const std::string_view& name);
+		static bool is_addon_modified(environment_config& env, virtual_machine* vm, const std::string_view& name);
 		static bool is_addon_target_exists(environment_config& env, virtual_machine* vm, const std::string_view& name, bool nested = false);
+		static bool read_byte_code(const std::string_view& path, byte_code_info* info);
 
 	private:
 		static status_code execute_git(system_config& config, const std::string_view& command);
-		static status_code execute_cmake(system_config& config, const std::string_view& command);
-		static bool execute_command(system_config& config, const std::string_view& label, const std::string_view& command, int success_exit_code);
+		static status_code execute_cmake(system_config& config, const std::string_view& command, const std::string_view& prefix = std::string_view());
+		static status_code build_into_executable(system_config& config, environment_config& env, const std::string_view& configure_command);
+		static status_code build_into_addon(system_config& config, environment_config& env, const std::string_view& name, size_t parallel);
+		static bool execute_command(system_config& config, const std::string_view& label, const std::string_view& command, int success_exit_code, const std::string_view& prefix = std::string_view());
 		static bool append_template(const unordered_map<string, string>& keys, const std::string_view& target_path, const std::string_view& template_path);
 		static bool append_byte_code(system_config& config, environment_config& env, const std::string_view& path);
+		static bool append_native_code(system_config& config, environment_config& env, const std::string_view& path, bool& translated);
 		static bool append_dependencies(environment_config& env, virtual_machine* vm, const std::string_view& target_directory);
 		static bool append_vitex(system_config& config);
+		static bool append_vitex_library(system_config& config, const unordered_map<string, string>& keys, string& library_path);
+		static bool update_file(const std::string_view& path, const uint8_t* data, size_t size);
 		static bool is_directory_empty(const std::string_view& target);
+		static bool restore_addon_cache(const std::string_view& cache_directory, const std::string_view& target_directory);
+		static bool store_addon_cache(const std::string_view& cache_directory, const std::string_view& target_directory, const vector<string>& files);
+		static bool link_file(const std::string_view& from, const std::string_view& to);
 		static const char* get_build_type(system_config& config);
 		static string get_global_vitex_path();
+		static string get_global_addons_path();
+		static string get_addon_cache_directory(system_config& config, environment_config& env, const std::string_view& name);
+		static bool is_addon_dirty(environment_config& env, const std::string_view& name);
+		static string get_addon_lock_path(environment_config& env);
+		static string get_addon_source(environment_config& env, const std::string_view& name);
+		static string get_addon_hash(environment_config& env, virtual_machine* vm, const std::string_view& name);
+		static string get_addon_revision(environment_config& env, const std::string_view& name);
 		static string get_building_directory(environment_config& env, const std::string_view& local_target);
 		static string get_global_targets_directory(environment_config& env, const std::string_view& name);
 		static string get_local_targets_directory(environment_config& env, const std::string_view& name);
@@ -55,6 +77,51 @@ namespace asx
 		static bool has(system_config& config, access_option option);
 	};
 
+	class code_cache
+	{
+	public:
+		static constexpr size_t max_entries = 64;
+
+	public:
+		static bool load(system_config& config, environment_config& env, virtual_machine* vm, compiler* unit, const unordered_map<string, uint32_t>& settings);
+		static bool store(system_config& config, environment_config& env, virtual_machine* vm, compiler* unit, const unordered_map<string, uint32_t>& settings);
+		static bool store_graph(environment_config& env, virtual_machine* vm, schema* includes = nullptr);
+		static void prune(const std::string_view& directory);
+		static bool append_include(schema* includes, const std::string_view& path);
+		static bool is_unchanged(schema* includes);
+		static size_t get_init_modules(const std::string_view& registry, const std::string_view& path, size_t modules);
+		static schema* get_graph(const std::string_view& registry, const std::string_view& path);
+		static schema* get_includes(environment_config& env, virtual_machine* vm);
+		static string get_key(system_config& config, environment_config& env, virtual_machine* vm, const unordered_map<string, uint32_t>& settings);
+		static string get_directory(environment_config& env);
+		static string get_hash(const std::string_view& data);
+	};
+
+	class benchmark
+	{
+	public:
+		static bool execute(environment_config& env, virtual_machine* vm, immediate_context* context, compiler* unit);
+		static bool execute_expression(virtual_machine* vm, immediate_context* context, compiler* unit, const std::string_view& expression, bool repeat);
+
+	private:
+		static schema* execute_target(benchmark_target& target, virtual_machine* vm, immediate_context* context, compiler* unit);
+		static schema* execute_function(const std::string_view& name, function& entry, size_t warmup, size_t iterations, virtual_machine* vm, immediate_context* context);
+		static bool execute_call(immediate_context* context, function& target);
+		static string get_summary(schema* result);
+		static string get_duration(double nanoseconds);
+	};
+
+	class aot_translator
+	{
+	public:
+		static size_t translate(compiler* unit, string& output);
+
+	private:
+		static bool translate_function(asIScriptFunction* function, size_t index, string& output, string& table);
+		static string translate_instruction(const asDWORD* byte_code, asUINT offset, asUINT size);
+		static string get_exit(asUINT offset);
+	};
+
 	class templates
 	{
 	private:
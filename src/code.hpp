@@ -15,35 +15,53 @@ namespace code_bundle
 		const char* sc_addon_addon_as = "import from \"console\";\n\nvoid print_hello_world()\n{\n    console@ log = console::get();\n    log.write_line(\"Hello, World\");\n}";
 		callback(context, "addon/addon.as", sc_addon_addon_as, 123);
 
-		const char* sc_addon_addon_cpp = "#include <iostream>\n#include \"interface.hpp\"\n\nvoid print_hello_world()\n{\n    std::cout << \"Hello, world!\" << std::endl;\n}\n\nextern \"C\" { INTERFACE_EXPORT int addon_import(); }\nint addon_import()\n{\n    asx_import_interface();\n    asx_export_function(\"void print_hello_world()\", &print_hello_world);\n    return 0;\n}\n\nextern \"C\" { INTERFACE_EXPORT void addon_cleanup(); }\nvoid addon_cleanup() { }";
-		callback(context, "addon/addon.cpp", sc_addon_addon_cpp, 392);
+		const char* sc_addon_addon_cpp = "#include <iostream>\n#include \"interface.hpp\"\n\nvoid print_hello_world()\n{\n    std::cout << \"Hello, world!\" << std::endl;\n}\n\nextern \"C\" { INTERFACE_EXPORT int addon_import(); }\nint addon_import()\n{\n    static const asx_function_info functions[] = { asx_function_entry(\"void print_hello_world()\", &print_hello_world) };\n    static const asx_namespace_info namespaces[] = { asx_namespace_entry(\"\", functions) };\n    asx_import_interface();\n    return asx_export(namespaces) ? 0 : -1;\n}\n\nextern \"C\" { INTERFACE_EXPORT void addon_cleanup(); }\nvoid addon_cleanup() { }";
+		callback(context, "addon/addon.cpp", sc_addon_addon_cpp, 561);
 
 		const char* sc_addon_addon_json = "{\n    \"name\": \"{{BUILDER_OUTPUT}}\",\n    \"type\": \"{{BUILDER_MODE}}\",\n    \"runtime\": \"{{BUILDER_VERSION}}\",\n    \"version\": \"1.0.0\",\n    \"index\": {{BUILDER_INDEX}}\n}";
 		callback(context, "addon/addon.json", sc_addon_addon_json, 162);
 
 		std::string dc_addon_interface_hpp;
-		dc_addon_interface_hpp.reserve(7462);
-		dc_addon_interface_hpp += "#ifndef ASX_INTERFACE_HPP\n#define ASX_INTERFACE_HPP\n#ifdef _WIN32\n#include <windows.h>\n#define INTERFACE_OPEN() GetModuleHandle(nullptr)\n#define INTERFACE_LOAD(handle, name) (void*)GetProcAddress(handle, #name)\n#define INTERFACE_CLOSE(handle) (void)0\n#define INTERFACE_EXPORT __declspec(dllexport)\n#else\n#include <dlfcn.h>\n#define INTERFACE_OPEN() dlopen(nullptr, RTLD_LAZY)\n#define INTERFACE_LOAD(handle, name) dlsym(handle, #name)\n#define INTERFACE_CLOSE(handle) dlclose(handle);\n#define INTERFACE_EXPORT\n#endif\nnamespace\n{\n\tvoid(*asx_import_builtin)(const char* path) = nullptr;\n\tvoid(*asx_import_native)(const char* path) = nullptr;\n\tvoid(*asx_export_property)(const char* declaration, void* property_address) = nullptr;\n\tvoid(*asx_export_function_address)(const char* declaration, void(*function_address)()) = nullptr;\n\tvoid(*asx_export_namespace_begin)(const char* name) = nullptr;\n\tvoid(*asx_export_namespace_end)() = nullptr;\n\tvoid(*asx_export_enum)(const char* name) = nullptr;\n\tvoid(*asx_export_enum_value)(const char* name, const char* declaration, int value) = nullptr;\n\tvoid(*asx_export_class_address)(const char* name, size_t size, size_t flags) = nullptr;\n\tvoid(*asx_export_class_property_address)(const char* name, const char* declaration, int property_offset) = nullptr;\n\tvoid(*asx_export_class_constructor_address)(const char* name, const char* declaration, void(*constructor_function_address)(void*)) = nullptr;\n\tvoid(*asx_export_class_operator_address)(const char* name, const char* declaration, void(*operator_function_address)()) = nullptr;\n\tvoid(*asx_export_class_copy_operator_address)(const char* name, void(*copy_operator_function_address)()) = nullptr;\n\tvoid(*asx_export_class_destructor_address)(const char* name, void(*destructor_function_address)(void*)) = nullptr;\n\tvoid(*asx_export_class_method_address)(const char* name, const char* declaration, void(*method_function_address)()) = nullptr;\n}\n\ntemplate <typename t, typename r, typename... args>\nstatic auto asx_operator(r(t::*value)(args...))\n{\n    return value;\n}\ntemplate <typename t, typename r, typename... args>\nstatic auto asx_operator(r(t::*value)(args...) const)\n{\n    return value;\n}\ntemplate <typename t, typename... args>\nstatic void asx_constructor(void* memory, args... data)\n{\n\tnew(memory) t(data...);\n}\ntemplate <typename t>\nstatic void asx_destructor(void* memory)\n{\n\t((t*)memory)->~t();\n}\ntemplate <typename t>\nvoid asx_export_function(const char* declaration, t function)\n{\n\tvoid(*function_address)() = reinterpret_cast<void(*)()>(size_t(function));\n\tasx_export_function_address(declaration, function_address);\n}\ntemplate <typename t>\nvoid asx_export_class(const char* name)\n{\n\tasx_export_class_address(name, sizeof(t),\n\t\t(std::is_default_constructible<t>::value ? 1 << 0 : 0) |\n\t\t(std::is_destructible<t>::value ? 1 << 1 : 0) |\n\t\t(std::is_copy_assignable<t>::value ? 1 << 2 : 0) |\n\t\t(std::is_copy_constructible<t>::value ? 1 << 4 : 0));\n}\ntemplate <typename t, typename r>\nvoid asx_export_class_property(const char* name, const char* declaration, r t::* value)\n{\n\tasx_export_class_property_address(name, declaration, (int)reinterpret_cast<size_t>(&(((t*)0)->*value)));\n}\ntemplate <typename t, typename... args>\nvoid asx_export_class_constructor(const char* name)\n{\n\tvoid(*constructor_address)(void*) = reinterpret_cast<void(*)(void*)>(&asx_constructor<t, args...>);\n\tasx_export_class_constructor_address(name, \"void f()\", constructor_address);\n}\ntemplate <typename t, typename... args>\nvoid asx_export_class_constructor(const char* name, const char* declaration)\n{\n\tvoid(*constructor_address)(void*) = reinterpret_cast<void(*)(void*)>(&asx_constructor<t, args...>);\n\tasx_export_class_constructor_address(name, declaration, constructor_address);\n}\ntemplate <typename t, typename r, typename... args>\nvoid asx_export_class_operator(const char* name, const char* declaration, r(t::* value)(args...))\n{\n    void(*operator_address)() = reinterpret_cast<void(*)()>(value);\n    asx_export_class_operator_address(name, declaration, operator_address);\n}\ntemplate <typename t, typename r, typename... ar";
-		dc_addon_interface_hpp += "gs>\nvoid asx_export_class_operator(const char* name, const char* declaration, r(t::* value)(args...) const)\n{\n    void(*operator_address)() = reinterpret_cast<void(*)()>(value);\n\tasx_export_class_operator_address(name, declaration, operator_address);\n}\ntemplate <typename t, typename r, typename... args>\nvoid asx_export_class_copy_operator(const char* name)\n{\n\tvoid(*operator_address)() = reinterpret_cast<void(*)()>(asx_operator<t, r, args...>(&t::operator =));\n\tasx_export_class_copy_operator_address(name, operator_address);\n}\ntemplate <typename t, typename... args>\nvoid asx_export_class_destructor(const char* name)\n{\n\tvoid(*destructor_address)(void*) = reinterpret_cast<void(*)(void*)>(&asx_destructor<t, args...>);\n\tasx_export_class_destructor_address(name, destructor_address);\n}\ntemplate <typename t, typename r, typename... args>\nvoid asx_export_class_method(const char* name, const char* declaration, r(t::* value)(args...))\n{\n\tvoid(*method_function_address)() = reinterpret_cast<void(*)()>(value);\n\tasx_export_class_method_address(name, declaration, method_function_address);\n}\ntemplate <typename t, typename r, typename... args>\nvoid asx_export_class_method(const char* name, const char* declaration, r(t::* value)(args...) const)\n{\n\tvoid(*method_function_address)() = reinterpret_cast<void(*)()>(value);\n\tasx_export_class_method_address(name, declaration, method_function_address);\n}\nvoid asx_import_interface()\n{\n    auto handle = INTERFACE_OPEN();\n    asx_import_builtin = (decltype(asx_import_builtin))INTERFACE_LOAD(handle, asx_import_builtin);\n    asx_import_native = (decltype(asx_import_native))INTERFACE_LOAD(handle, asx_import_native);\n    asx_export_property = (decltype(asx_export_property))INTERFACE_LOAD(handle, asx_export_property);\n    asx_export_function_address = (decltype(asx_export_function_address))INTERFACE_LOAD(handle, asx_export_function_address);\n    asx_export_namespace_begin = (decltype(asx_export_namespace_begin))INTERFACE_LOAD(handle, asx_export_namespace_begin);\n    asx_export_namespace_end = (decltype(asx_export_namespace_end))INTERFACE_LOAD(handle, asx_export_namespace_end);\n    asx_export_enum = (decltype(asx_export_enum))INTERFACE_LOAD(handle, asx_export_enum);\n    asx_export_enum_value = (decltype(asx_export_enum_value))INTERFACE_LOAD(handle, asx_export_enum_value);\n    asx_export_class_address = (decltype(asx_export_class_address))INTERFACE_LOAD(handle, asx_export_class_address);\n    asx_export_class_property_address = (decltype(asx_export_class_property_address))INTERFACE_LOAD(handle, asx_export_class_property_address);\n    asx_export_class_constructor_address = (decltype(asx_export_class_constructor_address))INTERFACE_LOAD(handle, asx_export_class_constructor_address);\n    asx_export_class_operator_address = (decltype(asx_export_class_operator_address))INTERFACE_LOAD(handle, asx_export_class_operator_address);\n    asx_export_class_copy_operator_address = (decltype(asx_export_class_copy_operator_address))INTERFACE_LOAD(handle, asx_export_class_copy_operator_address);\n    asx_export_class_destructor_address = (decltype(asx_export_class_destructor_address))INTERFACE_LOAD(handle, asx_export_class_destructor_address);\n    asx_export_class_method_address = (decltype(asx_export_class_method_address))INTERFACE_LOAD(handle, asx_export_class_method_address);\n\tINTERFACE_CLOSE(handle);\n}\n#endif\n";
+		dc_addon_interface_hpp.reserve(21479);
+		dc_addon_interface_hpp += "#ifndef ASX_INTERFACE_HPP\n#define ASX_INTERFACE_HPP\n#ifdef _WIN32\n#include <windows.h>\n#define INTERFACE_OPEN() GetModuleHandle(nullptr)\n#define INTERFACE_LOAD(handle, name) (void*)GetProcAddress(handle, #name)\n#define INTERFACE_CLOSE(handle) (void)0\n#define INTERFACE_EXPORT __declspec(dllexport)\n#else\n#include <dlfcn.h>\n#define INTERFACE_OPEN() dlopen(nullptr, RTLD_LAZY)\n#define INTERFACE_LOAD(handle, name) dlsym(handle, #name)\n#define INTERFACE_CLOSE(handle) dlclose(handle);\n#define INTERFACE_EXPORT\n#endif\n#include <cstddef>\n#include <type_traits>\n#include <new>\n#include <cstdint>\n#include <string>\n#include <utility>\n#ifndef ASX_INTERFACE_VERSION\n#define ASX_INTERFACE_VERSION 4\nenum asx_member_type\n{\n\tasx_member_method = 0,\n\tasx_member_operator = 1,\n\tasx_member_constructor = 2,\n\tasx_member_copy_operator = 3,\n\tasx_member_destructor = 4\n};\n\nstruct asx_enum_value_info\n{\n\tconst char* declaration;\n\tint value;\n};\n\nstruct asx_enum_info\n{\n\tconst char* name;\n\tconst asx_enum_value_info* values;\n\tsize_t values_count;\n};\n\nstruct asx_property_info\n{\n\tconst char* declaration;\n\tvoid* address;\n};\n\nstruct asx_function_info\n{\n\tconst char* declaration;\n\tvoid(*address)();\n};\n\nstruct asx_class_property_info\n{\n\tconst char* declaration;\n\tint offset;\n};\n\nstruct asx_class_method_info\n{\n\tasx_member_type type;\n\tconst char* declaration;\n\tvoid(*address)();\n};\n\nstruct asx_class_info\n{\n\tconst char* name;\n\tsize_t size;\n\tsize_t flags;\n\tconst asx_class_property_info* properties;\n\tsize_t properties_count;\n\tconst asx_class_method_info* methods;\n\tsize_t methods_count;\n};\n\nstruct asx_namespace_info\n{\n\tconst char* name;\n\tconst asx_enum_info* enums;\n\tsize_t enums_count;\n\tconst asx_class_info* classes;\n\tsize_t classes_count;\n\tconst asx_function_info* functions;\n\tsize_t functions_count;\n\tconst asx_property_info* properties;\n\tsize_t properties_count;\n};\n\nstruct asx_buffer\n{\n\tunsigned char* data;\n\tsize_t size;\n};\n\nstruct asx_promise;\n\nstruct asx_interface_table\n{\n\tsize_t version;\n\tvoid(*import_builtin)(const char* path);\n\tvoid(*import_native)(const char* path);\n\tvoid(*export_property)(const char* declaration, void* property_address);\n\tvoid(*export_function_address)(const char* declaration, void(*function_address)());\n\tvoid(*export_namespace_begin)(const char* name);\n\tvoid(*export_namespace_end)();\n\tvoid(*export_enum)(const char* name);\n\tvoid(*export_enum_value)(const char* name, const char* declaration, int value);\n\tvoid(*export_class_address)(const char* name, size_t size, size_t flags);\n\tvoid(*export_class_property_address)(const char* name, const char* declaration, int property_offset);\n\tvoid(*export_class_constructor_address)(const char* name, const char* declaration, void(*constructor_function_address)(void*));\n\tvoid(*export_class_operator_address)(const char* name, const char* declaration, void(*operator_function_address)());\n\tvoid(*export_class_copy_operator_address)(const char* name, void(*copy_operator_function_address)());\n\tvoid(*export_class_destructor_address)(const char* name, void(*destructor_function_address)(void*));\n\tvoid(*export_class_method_address)(const char* name, const char* declaration, void(*method_function_address)());\n\tint(*export_namespaces)(size_t version, const asx_namespace_info* namespaces, size_t namespaces_count);\n\tasx_buffer*(*buffer_create)(size_t size);\n\tasx_buffer*(*buffer_wrap)(void* data, size_t size, void(*release_callback)(void* data, void* context), void* context);\n\tvoid(*buffer_add_ref)(asx_buffer* buffer);\n\tvoid(*buffer_release)(asx_buffer* buffer);\n\tasx_promise*(*promise_create)(const char* type);\n\tvoid(*promise_resolve_void)(asx_promise* target);\n\tvoid(*promise_resolve_integer)(asx_promise* target, int64_t value);\n\tvoid(*promise_resolve_number)(asx_promise* target, double value);\n\tvoid(*promise_resolve_string)(asx_promise* target, const char* data, size_t size);\n\tvoid(*promise_resolve_buffer)(asx_promise* target, asx_buffer* value);\n\tvoid(*promise_reject)(asx_promise* target, const char* message);\n\tbool(*execute_async)(void(*callback)(void* context), void* context);\n};\n#endif\nnamespace\n{\n\tvoid(*asx_import_builtin)(c";
+		dc_addon_interface_hpp += "onst char* path) = nullptr;\n\tvoid(*asx_import_native)(const char* path) = nullptr;\n\tvoid(*asx_export_property)(const char* declaration, void* property_address) = nullptr;\n\tvoid(*asx_export_function_address)(const char* declaration, void(*function_address)()) = nullptr;\n\tvoid(*asx_export_namespace_begin)(const char* name) = nullptr;\n\tvoid(*asx_export_namespace_end)() = nullptr;\n\tvoid(*asx_export_enum)(const char* name) = nullptr;\n\tvoid(*asx_export_enum_value)(const char* name, const char* declaration, int value) = nullptr;\n\tvoid(*asx_export_class_address)(const char* name, size_t size, size_t flags) = nullptr;\n\tvoid(*asx_export_class_property_address)(const char* name, const char* declaration, int property_offset) = nullptr;\n\tvoid(*asx_export_class_constructor_address)(const char* name, const char* declaration, void(*constructor_function_address)(void*)) = nullptr;\n\tvoid(*asx_export_class_operator_address)(const char* name, const char* declaration, void(*operator_function_address)()) = nullptr;\n\tvoid(*asx_export_class_copy_operator_address)(const char* name, void(*copy_operator_function_address)()) = nullptr;\n\tvoid(*asx_export_class_destructor_address)(const char* name, void(*destructor_function_address)(void*)) = nullptr;\n\tvoid(*asx_export_class_method_address)(const char* name, const char* declaration, void(*method_function_address)()) = nullptr;\n\tint(*asx_export_namespaces)(size_t version, const asx_namespace_info* namespaces, size_t namespaces_count) = nullptr;\n\tasx_buffer*(*asx_buffer_create)(size_t size) = nullptr;\n\tasx_buffer*(*asx_buffer_wrap)(void* data, size_t size, void(*release_callback)(void* data, void* context), void* context) = nullptr;\n\tvoid(*asx_buffer_add_ref)(asx_buffer* buffer) = nullptr;\n\tvoid(*asx_buffer_release)(asx_buffer* buffer) = nullptr;\n\tasx_promise*(*asx_promise_create)(const char* type) = nullptr;\n\tvoid(*asx_promise_resolve_void)(asx_promise* target) = nullptr;\n\tvoid(*asx_promise_resolve_integer)(asx_promise* target, int64_t value) = nullptr;\n\tvoid(*asx_promise_resolve_number)(asx_promise* target, double value) = nullptr;\n\tvoid(*asx_promise_resolve_string)(asx_promise* target, const char* data, size_t size) = nullptr;\n\tvoid(*asx_promise_resolve_buffer)(asx_promise* target, asx_buffer* value) = nullptr;\n\tvoid(*asx_promise_reject)(asx_promise* target, const char* message) = nullptr;\n\tbool(*asx_execute_async)(void(*callback)(void* context), void* context) = nullptr;\n}\n\ntemplate <typename t, typename r, typename... args>\nstatic auto asx_operator(r(t::*value)(args...))\n{\n    return value;\n}\ntemplate <typename t, typename r, typename... args>\nstatic auto asx_operator(r(t::*value)(args...) const)\n{\n    return value;\n}\ntemplate <typename t, typename... args>\nstatic void asx_constructor(void* memory, args... data)\n{\n\tnew(memory) t(data...);\n}\ntemplate <typename t>\nstatic void asx_destructor(void* memory)\n{\n\t((t*)memory)->~t();\n}\ntemplate <typename t>\nvoid asx_export_function(const char* declaration, t function)\n{\n\tvoid(*function_address)() = reinterpret_cast<void(*)()>(size_t(function));\n\tasx_export_function_address(declaration, function_address);\n}\ntemplate <typename t>\nstatic const char* asx_typed_declaration()\n{\n\ttypedef typename std::remove_cv<t>::type type;\n\tstatic_assert(std::is_void<type>::value || std::is_arithmetic<type>::value, \"typed functions accept and return only bool, integer and floating point values\");\n\tif constexpr (std::is_void<type>::value)\n\t\treturn \"void\";\n\telse if constexpr (std::is_same<type, bool>::value)\n\t\treturn \"bool\";\n\telse if constexpr (std::is_floating_point<type>::value)\n\t{\n\t\tstatic_assert(!std::is_same<type, long double>::value, \"long double cannot be passed to scripts\");\n\t\treturn sizeof(type) == sizeof(float) ? \"float\" : \"double\";\n\t}\n\telse if constexpr (sizeof(type) == 1)\n\t\treturn std::is_signed<type>::value ? \"int8\" : \"uint8\";\n\telse if constexpr (sizeof(type) == 2)\n\t\treturn std::is_signed<type>::value ? \"int16\" : \"uint16\";\n\telse if constexpr (sizeof(type) == 4)\n\t\treturn std::is_signed<type>::value ? \"int32\" : \"uint32\";\n\telse\n\t\treturn std::is_signed<type>::value ? \"i";
+		dc_addon_interface_hpp += "nt64\" : \"uint64\";\n}\ntemplate <typename r, typename... args>\nstatic std::string asx_typed_declaration(const char* name, r(*)(args...))\n{\n\tconst char* types[] = { asx_typed_declaration<args>()..., nullptr };\n\tstd::string declaration = asx_typed_declaration<r>();\n\tdeclaration += ' ';\n\tdeclaration += name;\n\tdeclaration += '(';\n\tfor (size_t i = 0; i < sizeof...(args); i++)\n\t{\n\t\tif (i > 0)\n\t\t\tdeclaration += \", \";\n\t\tdeclaration += types[i];\n\t}\n\tdeclaration += ')';\n\treturn declaration;\n}\ntemplate <auto function>\nvoid asx_export_typed_function(const char* name)\n{\n\t/* registered as is, engine calls it through native calling convention without any wrapper in between */\n\tstd::string declaration = asx_typed_declaration(name, function);\n\tasx_export_function(declaration.c_str(), function);\n}\ntemplate <typename t>\nstatic size_t asx_class_flags()\n{\n\treturn\n\t\t(std::is_default_constructible<t>::value ? 1 << 0 : 0) |\n\t\t(std::is_destructible<t>::value ? 1 << 1 : 0) |\n\t\t(std::is_copy_assignable<t>::value ? 1 << 2 : 0) |\n\t\t(std::is_copy_constructible<t>::value ? 1 << 4 : 0);\n}\ntemplate <typename t>\nvoid asx_export_class(const char* name)\n{\n\tasx_export_class_address(name, sizeof(t), asx_class_flags<t>());\n}\ntemplate <typename t, typename r>\nvoid asx_export_class_property(const char* name, const char* declaration, r t::* value)\n{\n\tasx_export_class_property_address(name, declaration, (int)reinterpret_cast<size_t>(&(((t*)0)->*value)));\n}\ntemplate <typename t, typename... args>\nvoid asx_export_class_constructor(const char* name)\n{\n\tvoid(*constructor_address)(void*) = reinterpret_cast<void(*)(void*)>(&asx_constructor<t, args...>);\n\tasx_export_class_constructor_address(name, \"void f()\", constructor_address);\n}\ntemplate <typename t, typename... args>\nvoid asx_export_class_constructor(const char* name, const char* declaration)\n{\n\tvoid(*constructor_address)(void*) = reinterpret_cast<void(*)(void*)>(&asx_constructor<t, args...>);\n\tasx_export_class_constructor_address(name, declaration, constructor_address);\n}\ntemplate <typename t, typename r, typename... args>\nvoid asx_export_class_operator(const char* name, const char* declaration, r(t::* value)(args...))\n{\n    void(*operator_address)() = reinterpret_cast<void(*)()>(value);\n    asx_export_class_operator_address(name, declaration, operator_address);\n}\ntemplate <typename t, typename r, typename... args>\nvoid asx_export_class_operator(const char* name, const char* declaration, r(t::* value)(args...) const)\n{\n    void(*operator_address)() = reinterpret_cast<void(*)()>(value);\n\tasx_export_class_operator_address(name, declaration, operator_address);\n}\ntemplate <typename t, typename r, typename... args>\nvoid asx_export_class_copy_operator(const char* name)\n{\n\tvoid(*operator_address)() = reinterpret_cast<void(*)()>(asx_operator<t, r, args...>(&t::operator =));\n\tasx_export_class_copy_operator_address(name, operator_address);\n}\ntemplate <typename t, typename... args>\nvoid asx_export_class_destructor(const char* name)\n{\n\tvoid(*destructor_address)(void*) = reinterpret_cast<void(*)(void*)>(&asx_destructor<t, args...>);\n\tasx_export_class_destructor_address(name, destructor_address);\n}\ntemplate <typename t, typename r, typename... args>\nvoid asx_export_class_method(const char* name, const char* declaration, r(t::* value)(args...))\n{\n\tvoid(*method_function_address)() = reinterpret_cast<void(*)()>(value);\n\tasx_export_class_method_address(name, declaration, method_function_address);\n}\ntemplate <typename t, typename r, typename... args>\nvoid asx_export_class_method(const char* name, const char* declaration, r(t::* value)(args...) const)\n{\n\tvoid(*method_function_address)() = reinterpret_cast<void(*)()>(value);\n\tasx_export_class_method_address(name, declaration, method_function_address);\n}\ntemplate <typename t>\nasx_function_info asx_function_entry(const char* declaration, t function)\n{\n\treturn { declaration, reinterpret_cast<void(*)()>(size_t(function)) };\n}\ntemplate <typename t>\nasx_property_info asx_property_entry(const char* declaration, t* value)\n{\n\treturn { declaration, (void*)value };\n}\ninline asx_enum_value_info asx_";
+		dc_addon_interface_hpp += "enum_value_entry(const char* declaration, int value)\n{\n\treturn { declaration, value };\n}\ntemplate <size_t n>\nasx_enum_info asx_enum_entry(const char* name, const asx_enum_value_info(&values)[n])\n{\n\treturn { name, values, n };\n}\ntemplate <typename t, typename r>\nasx_class_property_info asx_class_property_entry(const char* declaration, r t::* value)\n{\n\treturn { declaration, (int)reinterpret_cast<size_t>(&(((t*)0)->*value)) };\n}\ntemplate <typename t, typename r, typename... args>\nasx_class_method_info asx_class_method_entry(const char* declaration, r(t::* value)(args...))\n{\n\treturn { asx_member_method, declaration, reinterpret_cast<void(*)()>(value) };\n}\ntemplate <typename t, typename r, typename... args>\nasx_class_method_info asx_class_method_entry(const char* declaration, r(t::* value)(args...) const)\n{\n\treturn { asx_member_method, declaration, reinterpret_cast<void(*)()>(value) };\n}\ntemplate <typename t, typename r, typename... args>\nasx_class_method_info asx_class_operator_entry(const char* declaration, r(t::* value)(args...))\n{\n\treturn { asx_member_operator, declaration, reinterpret_cast<void(*)()>(value) };\n}\ntemplate <typename t, typename r, typename... args>\nasx_class_method_info asx_class_operator_entry(const char* declaration, r(t::* value)(args...) const)\n{\n\treturn { asx_member_operator, declaration, reinterpret_cast<void(*)()>(value) };\n}\ntemplate <typename t, typename... args>\nasx_class_method_info asx_class_constructor_entry(const char* declaration = \"void f()\")\n{\n\treturn { asx_member_constructor, declaration, reinterpret_cast<void(*)()>(&asx_constructor<t, args...>) };\n}\ntemplate <typename t, typename r, typename... args>\nasx_class_method_info asx_class_copy_operator_entry()\n{\n\treturn { asx_member_copy_operator, nullptr, reinterpret_cast<void(*)()>(asx_operator<t, r, args...>(&t::operator =)) };\n}\ntemplate <typename t>\nasx_class_method_info asx_class_destructor_entry()\n{\n\treturn { asx_member_destructor, nullptr, reinterpret_cast<void(*)()>(&asx_destructor<t>) };\n}\ntemplate <typename t>\nasx_class_info asx_class_entry(const char* name)\n{\n\treturn { name, sizeof(t), asx_class_flags<t>(), nullptr, 0, nullptr, 0 };\n}\ntemplate <typename t, size_t m>\nasx_class_info asx_class_entry(const char* name, const asx_class_method_info(&methods)[m])\n{\n\treturn { name, sizeof(t), asx_class_flags<t>(), nullptr, 0, methods, m };\n}\ntemplate <typename t, size_t p, size_t m>\nasx_class_info asx_class_entry(const char* name, const asx_class_property_info(&properties)[p], const asx_class_method_info(&methods)[m])\n{\n\treturn { name, sizeof(t), asx_class_flags<t>(), properties, p, methods, m };\n}\ntemplate <size_t n>\nvoid asx_namespace_append(asx_namespace_info& target, const asx_enum_info(&values)[n])\n{\n\ttarget.enums = values;\n\ttarget.enums_count = n;\n}\ntemplate <size_t n>\nvoid asx_namespace_append(asx_namespace_info& target, const asx_class_info(&values)[n])\n{\n\ttarget.classes = values;\n\ttarget.classes_count = n;\n}\ntemplate <size_t n>\nvoid asx_namespace_append(asx_namespace_info& target, const asx_function_info(&values)[n])\n{\n\ttarget.functions = values;\n\ttarget.functions_count = n;\n}\ntemplate <size_t n>\nvoid asx_namespace_append(asx_namespace_info& target, const asx_property_info(&values)[n])\n{\n\ttarget.properties = values;\n\ttarget.properties_count = n;\n}\ntemplate <typename... tables>\nasx_namespace_info asx_namespace_entry(const char* name, const tables&... values)\n{\n\tasx_namespace_info result = { name, nullptr, 0, nullptr, 0, nullptr, 0, nullptr, 0 };\n\t(asx_namespace_append(result, values), ...);\n\treturn result;\n}\ntemplate <size_t n>\nbool asx_export(const asx_namespace_info(&namespaces)[n])\n{\n\treturn asx_export_namespaces != nullptr && asx_export_namespaces(ASX_INTERFACE_VERSION, namespaces, n) == 0;\n}\nvoid asx_import_interface()\n{\n    auto handle = INTERFACE_OPEN();\n    auto asx_get_interface = (const asx_interface_table*(*)(size_t))INTERFACE_LOAD(handle, asx_get_interface);\n    auto* table = asx_get_interface ? asx_get_interface(ASX_INTERFACE_VERSION) : nullptr;\n    if (table != nullptr)\n    {\n        asx_import_builtin = table->import_b";
+		dc_addon_interface_hpp += "uiltin;\n        asx_import_native = table->import_native;\n        asx_export_property = table->export_property;\n        asx_export_function_address = table->export_function_address;\n        asx_export_namespace_begin = table->export_namespace_begin;\n        asx_export_namespace_end = table->export_namespace_end;\n        asx_export_enum = table->export_enum;\n        asx_export_enum_value = table->export_enum_value;\n        asx_export_class_address = table->export_class_address;\n        asx_export_class_property_address = table->export_class_property_address;\n        asx_export_class_constructor_address = table->export_class_constructor_address;\n        asx_export_class_operator_address = table->export_class_operator_address;\n        asx_export_class_copy_operator_address = table->export_class_copy_operator_address;\n        asx_export_class_destructor_address = table->export_class_destructor_address;\n        asx_export_class_method_address = table->export_class_method_address;\n        asx_export_namespaces = table->export_namespaces;\n        asx_buffer_create = table->buffer_create;\n        asx_buffer_wrap = table->buffer_wrap;\n        asx_buffer_add_ref = table->buffer_add_ref;\n        asx_buffer_release = table->buffer_release;\n        asx_promise_create = table->promise_create;\n        asx_promise_resolve_void = table->promise_resolve_void;\n        asx_promise_resolve_integer = table->promise_resolve_integer;\n        asx_promise_resolve_number = table->promise_resolve_number;\n        asx_promise_resolve_string = table->promise_resolve_string;\n        asx_promise_resolve_buffer = table->promise_resolve_buffer;\n        asx_promise_reject = table->promise_reject;\n        asx_execute_async = table->execute_async;\n        INTERFACE_CLOSE(handle);\n        return;\n    }\n\n    asx_import_builtin = (decltype(asx_import_builtin))INTERFACE_LOAD(handle, asx_import_builtin);\n    asx_import_native = (decltype(asx_import_native))INTERFACE_LOAD(handle, asx_import_native);\n    asx_export_property = (decltype(asx_export_property))INTERFACE_LOAD(handle, asx_export_property);\n    asx_export_function_address = (decltype(asx_export_function_address))INTERFACE_LOAD(handle, asx_export_function_address);\n    asx_export_namespace_begin = (decltype(asx_export_namespace_begin))INTERFACE_LOAD(handle, asx_export_namespace_begin);\n    asx_export_namespace_end = (decltype(asx_export_namespace_end))INTERFACE_LOAD(handle, asx_export_namespace_end);\n    asx_export_enum = (decltype(asx_export_enum))INTERFACE_LOAD(handle, asx_export_enum);\n    asx_export_enum_value = (decltype(asx_export_enum_value))INTERFACE_LOAD(handle, asx_export_enum_value);\n    asx_export_class_address = (decltype(asx_export_class_address))INTERFACE_LOAD(handle, asx_export_class_address);\n    asx_export_class_property_address = (decltype(asx_export_class_property_address))INTERFACE_LOAD(handle, asx_export_class_property_address);\n    asx_export_class_constructor_address = (decltype(asx_export_class_constructor_address))INTERFACE_LOAD(handle, asx_export_class_constructor_address);\n    asx_export_class_operator_address = (decltype(asx_export_class_operator_address))INTERFACE_LOAD(handle, asx_export_class_operator_address);\n    asx_export_class_copy_operator_address = (decltype(asx_export_class_copy_operator_address))INTERFACE_LOAD(handle, asx_export_class_copy_operator_address);\n    asx_export_class_destructor_address = (decltype(asx_export_class_destructor_address))INTERFACE_LOAD(handle, asx_export_class_destructor_address);\n    asx_export_class_method_address = (decltype(asx_export_class_method_address))INTERFACE_LOAD(handle, asx_export_class_method_address);\n    asx_export_namespaces = (decltype(asx_export_namespaces))INTERFACE_LOAD(handle, asx_export_namespaces);\n    asx_buffer_create = (decltype(asx_buffer_create))INTERFACE_LOAD(handle, asx_buffer_create);\n    asx_buffer_wrap = (decltype(asx_buffer_wrap))INTERFACE_LOAD(handle, asx_buffer_wrap);\n    asx_buffer_add_ref = (decltype(asx_buffer_add_ref))INTERFACE_LOAD(handle, asx_buffer_add_ref);\n    asx_buffer_release = (decltype(asx_bu";
+		dc_addon_interface_hpp += "ffer_release))INTERFACE_LOAD(handle, asx_buffer_release);\n    asx_promise_create = (decltype(asx_promise_create))INTERFACE_LOAD(handle, asx_promise_create);\n    asx_promise_resolve_void = (decltype(asx_promise_resolve_void))INTERFACE_LOAD(handle, asx_promise_resolve_void);\n    asx_promise_resolve_integer = (decltype(asx_promise_resolve_integer))INTERFACE_LOAD(handle, asx_promise_resolve_integer);\n    asx_promise_resolve_number = (decltype(asx_promise_resolve_number))INTERFACE_LOAD(handle, asx_promise_resolve_number);\n    asx_promise_resolve_string = (decltype(asx_promise_resolve_string))INTERFACE_LOAD(handle, asx_promise_resolve_string);\n    asx_promise_resolve_buffer = (decltype(asx_promise_resolve_buffer))INTERFACE_LOAD(handle, asx_promise_resolve_buffer);\n    asx_promise_reject = (decltype(asx_promise_reject))INTERFACE_LOAD(handle, asx_promise_reject);\n    asx_execute_async = (decltype(asx_execute_async))INTERFACE_LOAD(handle, asx_execute_async);\n\tINTERFACE_CLOSE(handle);\n}\n#endif\n";
 		callback(context, "addon/interface.hpp", dc_addon_interface_hpp.c_str(), (unsigned int)dc_addon_interface_hpp.size());
 
-		const char* sc_executable_cmakelists_txt = "cmake_minimum_required(VERSION 3.10)\nset(VI_DIRECTORY \"{{BUILDER_VENGEANCE_PATH}}\" CACHE STRING \"-\")\n{{BUILDER_FEATURES}}\ninclude(${VI_DIRECTORY}/deps/vitex/deps/toolchain.cmake)\nproject({{BUILDER_OUTPUT}})\nset(CMAKE_DISABLE_IN_SOURCE_BUILD ON)\nset(CMAKE_RUNTIME_OUTPUT_DIRECTORY ${CMAKE_SOURCE_DIR}/bin)\nset(CMAKE_RUNTIME_OUTPUT_DIRECTORY_DEBUG ${CMAKE_SOURCE_DIR}/bin)\nset(CMAKE_RUNTIME_OUTPUT_DIRECTORY_RELEASE ${CMAKE_SOURCE_DIR}/bin)\nset(CMAKE_RUNTIME_OUTPUT_DIRECTORY_RELWITHDEBINFO ${CMAKE_SOURCE_DIR}/bin)\nset(BUFFER_DATA \"#ifndef HAS_PROGRAM_BYTECODE\\n#define HAS_PROGRAM_BYTECODE\\n#include <string>\\n\\nnamespace program_bytecode\\n{\\n\\tvoid foreach(void* context, void(*callback)(void*, const char*, unsigned))\\n\\t{\\n\\t\\tif (!callback)\\n\\t\\t\\treturn;\\n\")\nset(BUFFER_OUT \"${CMAKE_SOURCE_DIR}/program\")\nset(FILENAME \"program_bytecode\")\nfile(READ \"${CMAKE_SOURCE_DIR}/program.b64\" FILEDATA)\nif (NOT FILEDATA STREQUAL \"\")\n    string(LENGTH \"${FILEDATA}\" FILESIZE)\n    if (FILESIZE GREATER 4096)\n        set(FILEOFFSET 0)\n        string(APPEND BUFFER_DATA \"\\n\\t\\tstd::string dc_${FILENAME};\\n\\t\\tdc_${FILENAME}.reserve(${FILESIZE});\")\n        while (FILEOFFSET LESS FILESIZE)\n            math(EXPR CHUNKSIZE \"${FILESIZE}-${FILEOFFSET}\")\n            if (CHUNKSIZE GREATER 4096)\n                set(CHUNKSIZE 4096)\n                string(SUBSTRING \"${FILEDATA}\" \"${FILEOFFSET}\" \"${CHUNKSIZE}\" CHUNKDATA)\n            else()\n                string(SUBSTRING \"${FILEDATA}\" \"${FILEOFFSET}\" \"-1\" CHUNKDATA)\n            endif()\n            string(APPEND BUFFER_DATA \"\\n\\t\\tdc_${FILENAME} += \\\"${CHUNKDATA}\\\";\")\n            math(EXPR FILEOFFSET \"${FILEOFFSET}+${CHUNKSIZE}\")\n        endwhile()\n        string(APPEND BUFFER_DATA \"\\n\\t\\tcallback(context, dc_${FILENAME}.c_str(), (unsigned int)dc_${FILENAME}.size());\\n\")\n    else()\n        string(APPEND BUFFER_DATA \"\\n\\t\\tconst char* sc_${FILENAME} = \\\"${FILEDATA}\\\";\\n\\t\\tcallback(context, sc_${FILENAME}, ${FILESIZE});\\n\")\n    endif()    \nendif()\nstring(APPEND BUFFER_DATA \"\\t}\\n}\\n#endif\")\nfile(WRITE ${BUFFER_OUT}.hpp \"${BUFFER_DATA}\")\t\nlist(APPEND SOURCE \"${BUFFER_OUT}.hpp\")\nadd_executable({{BUILDER_OUTPUT}}\n    ${CMAKE_CURRENT_SOURCE_DIR}/runtime.hpp\n    ${CMAKE_CURRENT_SOURCE_DIR}/program.hpp\n    ${CMAKE_CURRENT_SOURCE_DIR}/program.cpp)\nset_target_properties({{BUILDER_OUTPUT}} PROPERTIES\n    OUTPUT_NAME \"{{BUILDER_OUTPUT}}\"\n    CXX_STANDARD ${VI_CXX}\n    CXX_STANDARD_REQUIRED ON\n    CXX_EXTENSIONS OFF\n    VERSION ${PROJECT_VERSION}\n    SOVERSION ${PROJECT_VERSION})\nif (MSVC AND {{BUILDER_APPLICATION}})\n    set(CMAKE_EXE_LINKER_FLAGS \"/ENTRY:mainCRTStartup /SUBSYSTEM:WINDOWS\")\nendif()\nadd_subdirectory(${VI_DIRECTORY} vitex)\nlink_directories(${VI_DIRECTORY})\ntarget_include_directories({{BUILDER_OUTPUT}} PRIVATE ${VI_DIRECTORY})\ntarget_link_libraries({{BUILDER_OUTPUT}} PRIVATE vitex)";
-		callback(context, "executable/CMakeLists.txt", sc_executable_cmakelists_txt, 2846);
+		std::string dc_executable_cmakelists_txt;
+		dc_executable_cmakelists_txt.reserve(5824);
+		dc_executable_cmakelists_txt += "cmake_minimum_required(VERSION 3.10)\nset(VI_DIRECTORY \"{{BUILDER_VENGEANCE_PATH}}\" CACHE STRING \"-\")\nset(VI_LIBRARY \"\" CACHE STRING \"-\")\nset(VI_LTO OFF CACHE BOOL \"-\")\nset(VI_AOT OFF CACHE BOOL \"-\")\nset(VI_PGO \"\" CACHE STRING \"-\")\nset(VI_PGO_DIRECTORY \"\" CACHE STRING \"-\")\n{{BUILDER_FEATURES}}\ninclude(${VI_DIRECTORY}/deps/vitex/deps/toolchain.cmake)\nproject({{BUILDER_OUTPUT}})\nset(CMAKE_DISABLE_IN_SOURCE_BUILD ON)\nif (VI_LTO OR (MSVC AND VI_PGO))\n    include(CheckIPOSupported)\n    check_ipo_supported(RESULT PROGRAM_IPO OUTPUT PROGRAM_IPO_ERROR)\n    if (PROGRAM_IPO)\n        set(CMAKE_INTERPROCEDURAL_OPTIMIZATION ON)\n    else()\n        message(WARNING \"LTO is not supported: ${PROGRAM_IPO_ERROR}\")\n    endif()\nendif()\nif (VI_PGO STREQUAL \"generate\")\n    if (MSVC)\n        set(PROGRAM_PGO_LINK_FLAGS \"/GENPROFILE:PGD=${VI_PGO_DIRECTORY}/program.pgd\")\n    else()\n        set(PROGRAM_PGO_FLAGS \"-fprofile-generate=${VI_PGO_DIRECTORY}\")\n        set(PROGRAM_PGO_LINK_FLAGS \"-fprofile-generate=${VI_PGO_DIRECTORY}\")\n    endif()\nelseif (VI_PGO STREQUAL \"use\")\n    if (MSVC)\n        set(PROGRAM_PGO_LINK_FLAGS \"/USEPROFILE:PGD=${VI_PGO_DIRECTORY}/program.pgd\")\n    elseif (CMAKE_CXX_COMPILER_ID MATCHES \"Clang\")\n        find_program(PROGRAM_PROFDATA llvm-profdata)\n        if (PROGRAM_PROFDATA)\n            set(PROGRAM_PROFDATA_COMMAND ${PROGRAM_PROFDATA})\n        elseif (APPLE)\n            set(PROGRAM_PROFDATA_COMMAND xcrun llvm-profdata)\n        else()\n            message(FATAL_ERROR \"PGO requires llvm-profdata\")\n        endif()\n        file(GLOB PROGRAM_PROFILES \"${VI_PGO_DIRECTORY}/*.profraw\")\n        execute_process(COMMAND ${PROGRAM_PROFDATA_COMMAND} merge -output=${VI_PGO_DIRECTORY}/program.profdata ${PROGRAM_PROFILES} RESULT_VARIABLE PROGRAM_PROFDATA_RESULT)\n        if (NOT PROGRAM_PROFDATA_RESULT EQUAL 0)\n            message(FATAL_ERROR \"PGO profile cannot be merged\")\n        endif()\n        set(PROGRAM_PGO_FLAGS \"-fprofile-use=${VI_PGO_DIRECTORY}/program.profdata -Wno-profile-instr-unprofiled -Wno-profile-instr-out-of-date\")\n        set(PROGRAM_PGO_LINK_FLAGS \"-fprofile-use=${VI_PGO_DIRECTORY}/program.profdata\")\n    else()\n        set(PROGRAM_PGO_FLAGS \"-fprofile-use=${VI_PGO_DIRECTORY} -fprofile-correction -Wno-missing-profile\")\n        set(PROGRAM_PGO_LINK_FLAGS \"-fprofile-use=${VI_PGO_DIRECTORY}\")\n    endif()\nendif()\nif (PROGRAM_PGO_FLAGS)\n    set(CMAKE_C_FLAGS \"${CMAKE_C_FLAGS} ${PROGRAM_PGO_FLAGS}\")\n    set(CMAKE_CXX_FLAGS \"${CMAKE_CXX_FLAGS} ${PROGRAM_PGO_FLAGS}\")\nendif()\nif (PROGRAM_PGO_LINK_FLAGS)\n    set(CMAKE_EXE_LINKER_FLAGS \"${CMAKE_EXE_LINKER_FLAGS} ${PROGRAM_PGO_LINK_FLAGS}\")\n    set(CMAKE_SHARED_LINKER_FLAGS \"${CMAKE_SHARED_LINKER_FLAGS} ${PROGRAM_PGO_LINK_FLAGS}\")\nendif()\nset(CMAKE_RUNTIME_OUTPUT_DIRECTORY ${CMAKE_SOURCE_DIR}/bin)\nset(CMAKE_RUNTIME_OUTPUT_DIRECTORY_DEBUG ${CMAKE_SOURCE_DIR}/bin)\nset(CMAKE_RUNTIME_OUTPUT_DIRECTORY_RELEASE ${CMAKE_SOURCE_DIR}/bin)\nset(CMAKE_RUNTIME_OUTPUT_DIRECTORY_RELWITHDEBINFO ${CMAKE_SOURCE_DIR}/bin)\nset(PROGRAM_BYTECODE \"${CMAKE_SOURCE_DIR}/program.bin\")\nset(PROGRAM_NATIVE_CODE \"${CMAKE_SOURCE_DIR}/aot.cpp\")\nset(PROGRAM_SOURCES\n    ${CMAKE_CURRENT_SOURCE_DIR}/runtime.hpp\n    ${CMAKE_CURRENT_SOURCE_DIR}/program.cpp)\nif (VI_AOT AND EXISTS \"${PROGRAM_NATIVE_CODE}\")\n    list(APPEND PROGRAM_SOURCES \"${PROGRAM_NATIVE_CODE}\")\n    if (NOT MSVC)\n        # Translated code accesses stack slots through differently typed pointers\n        set_source_files_properties(\"${PROGRAM_NATIVE_CODE}\" PROPERTIES COMPILE_OPTIONS \"-fno-strict-aliasing\")\n    endif()\nendif()\nif (EXISTS \"${PROGRAM_BYTECODE}\")\n    if (MSVC)\n        set(PROGRAM_EMBEDDING \"${CMAKE_SOURCE_DIR}/program.rc\")\n        file(WRITE \"${PROGRAM_EMBEDDING}\" \"PROGRAM_BYTECODE RCDATA \\\"${PROGRAM_BYTECODE}\\\"\\n\")\n    else()\n        enable_language(ASM)\n        set(PROGRAM_EMBEDDING \"${CMAKE_SOURCE_DIR}/program.S\")\n        if (APPLE)\n            set(PROGRAM_SECTION \".const_data\")\n            set(PROGRAM_SYMBOL \"_\")\n            set(PROGRAM_STACK \"\")\n        elseif (WIN32)\n            set(PROGRAM_SECTION \".section .rdata,\\\"dr\\\"\")\n            set(PROG";
+		dc_executable_cmakelists_txt += "RAM_SYMBOL \"\")\n            set(PROGRAM_STACK \"\")\n        else()\n            set(PROGRAM_SECTION \".section .rodata\")\n            set(PROGRAM_SYMBOL \"\")\n            set(PROGRAM_STACK \"\\t.section .note.GNU-stack,\\\"\\\",%progbits\\n\")\n        endif()\n        file(WRITE \"${PROGRAM_EMBEDDING}\" \"\\t${PROGRAM_SECTION}\\n\\t.globl ${PROGRAM_SYMBOL}program_bytecode_data\\n\\t.globl ${PROGRAM_SYMBOL}program_bytecode_end\\n\\t.balign 16\\n${PROGRAM_SYMBOL}program_bytecode_data:\\n\\t.incbin \\\"${PROGRAM_BYTECODE}\\\"\\n${PROGRAM_SYMBOL}program_bytecode_end:\\n\\t.byte 0\\n${PROGRAM_STACK}\")\n    endif()\n    set_source_files_properties(\"${PROGRAM_EMBEDDING}\" PROPERTIES OBJECT_DEPENDS \"${PROGRAM_BYTECODE}\")\n    list(APPEND PROGRAM_SOURCES \"${PROGRAM_EMBEDDING}\")\nendif()\nadd_executable({{BUILDER_OUTPUT}} ${PROGRAM_SOURCES})\nif (EXISTS \"${PROGRAM_BYTECODE}\")\n    target_compile_definitions({{BUILDER_OUTPUT}} PRIVATE -DHAS_PROGRAM_BYTECODE)\nendif()\nif (VI_AOT AND EXISTS \"${PROGRAM_NATIVE_CODE}\")\n    target_compile_definitions({{BUILDER_OUTPUT}} PRIVATE -DHAS_PROGRAM_AOT)\nendif()\nset_target_properties({{BUILDER_OUTPUT}} PROPERTIES\n    OUTPUT_NAME \"{{BUILDER_OUTPUT}}\"\n    CXX_STANDARD ${VI_CXX}\n    CXX_STANDARD_REQUIRED ON\n    CXX_EXTENSIONS OFF\n    VERSION ${PROJECT_VERSION}\n    SOVERSION ${PROJECT_VERSION})\nif (MSVC AND {{BUILDER_APPLICATION}})\n    set(CMAKE_EXE_LINKER_FLAGS \"${CMAKE_EXE_LINKER_FLAGS} /ENTRY:mainCRTStartup /SUBSYSTEM:WINDOWS\")\nendif()\nif (VI_LIBRARY AND EXISTS \"${VI_LIBRARY}\")\n    include(\"${VI_LIBRARY}\")\nelse()\n    add_subdirectory(${VI_DIRECTORY} vitex)\nendif()\nlink_directories(${VI_DIRECTORY})\ntarget_include_directories({{BUILDER_OUTPUT}} PRIVATE ${VI_DIRECTORY})\ntarget_link_libraries({{BUILDER_OUTPUT}} PRIVATE vitex)";
+		callback(context, "executable/CMakeLists.txt", dc_executable_cmakelists_txt.c_str(), (unsigned int)dc_executable_cmakelists_txt.size());
 
 		std::string dc_executable_program_cpp;
-		dc_executable_program_cpp.reserve(5191);
-		dc_executable_program_cpp += "#include \"program.hpp\"\n#include \"runtime.hpp\"\n#include <vengeance/vengeance.h>\n#include <vengeance/bindings.h>\n#include <vengeance/layer.h>\n#include <signal.h>\n\nusing namespace vitex::layer;\nusing namespace asx;\n\nevent_loop* loop = nullptr;\nvirtual_machine* vm = nullptr;\ncompiler* unit = nullptr;\nimmediate_context* context = nullptr;\nstd::mutex mutex;\nint exit_code = 0;\n\nvoid exit_program(int sigv)\n{\n\tif (sigv != SIGINT && sigv != SIGTERM)\n\t\treturn;\n\n\tumutex<std::mutex> unique(mutex);\n\t{\n\t\tif (runtime::try_context_exit(environment_config::get(), sigv))\n\t\t{\n\t\t\tloop->wakeup();\n\t\t\tgoto graceful_shutdown;\n\t\t}\n\n\t\tauto* app = application::get();\n\t\tif (app != nullptr && app->get_state() == application_state::active)\n\t\t{\n\t\t\tapp->stop();\n\t\t\tloop->wakeup();\n\t\t\tgoto graceful_shutdown;\n\t\t}\n\n\t\tif (schedule::is_available())\n\t\t{\n\t\t\tschedule::get()->stop();\n\t\t\tloop->wakeup();\n\t\t\tgoto graceful_shutdown;\n\t\t}\n\n\t\treturn std::exit((int)exit_status::kill);\n\t}\ngraceful_shutdown:\n\tsignal(sigv, &exit_program);\n}\nvoid setup_program(environment_config& env)\n{\n\tos::directory::set_working(env.path.c_str());\n\tsignal(SIGINT, &exit_program);\n\tsignal(SIGTERM, &exit_program);\n#ifdef VI_UNIX\n\tsignal(SIGPIPE, SIG_IGN);\n\tsignal(SIGCHLD, SIG_IGN);\n#endif\n}\nbool load_program(environment_config& env)\n{\n#ifdef HAS_PROGRAM_BYTECODE\n\tprogram_bytecode::foreach(&env, [](void* context, const char* buffer, unsigned size)\n\t{\n\t\tenvironment_config* env = (environment_config*)context;\n\t\tenv->program = codec::base64_decode(std::string_view(buffer, (size_t)size));\n\t});\n\treturn true;\n#else\n\treturn false;\n#endif\n}\nint main(int argc, char* argv[])\n{\n\tenvironment_config env;\n\tenv.path = *os::directory::get_module();\n\tenv.library = argc > 0 ? argv[0] : \"runtime\";\n\tenv.auto_schedule = {{BUILDER_ENV_AUTO_SCHEDULE}};\n\tenv.auto_console = {{BUILDER_ENV_AUTO_CONSOLE}};\n\tenv.auto_stop = {{BUILDER_ENV_AUTO_STOP}};\n\tif (!load_program(env))\n\t\treturn 0;\n\n\tvector<string> args;\n\targs.reserve((size_t)argc);\n\tfor (int i = 0; i < argc; i++)\n\t\targs.push_back(argv[i]);\n\n\tsystem_config config;\n\tconfig.permissions = { {{BUILDER_CONFIG_PERMISSIONS}} };\n\tconfig.libraries = { {{BUILDER_CONFIG_LIBRARIES}} };\n\tconfig.functions = { {{BUILDER_CONFIG_FUNCTIONS}} };\n\tconfig.system_addons = { {{BUILDER_CONFIG_ADDONS}} };\n\tconfig.tags = {{BUILDER_CONFIG_TAGS}};\n\tconfig.ts_imports = {{BUILDER_CONFIG_TS_IMPORTS}};\n\tconfig.essentials_only = {{BUILDER_CONFIG_ESSENTIALS_ONLY}};\n\tconfig.save_source_code = {{BUILDER_CONFIG_SAVE_SOURCE_CODE}};\n\tconfig.full_stack_tracing = {{BUILDER_CONFIG_FULL_STACK_TRACING}};\n\tsetup_program(env);\n\n\tsize_t modules = vitex::use_networking | vitex::use_cryptography | vitex::use_providers | vitex::use_locale;\n\tif (!config.essentials_only)\n\t\tmodules |= vitex::use_platform | vitex::use_audio | vitex::use_graphics;\n\n\tvitex::heavy_runtime scope(modules);\n\t{\n\t\tvm = new virtual_machine();\n\t\tbindings::heavy_registry().bind_addons(vm);\n\t\tunit = vm->create_compiler();\n\t\tcontext = vm->request_context();\n\n\t\tvector<std::pair<uint32_t, size_t>> settings = { {{BUILDER_CONFIG_SETTINGS}} };\n\t\tfor (auto& item : settings)\n\t\t\tvm->set_property((features)item.first, item.second);\n\n\t\tunit = vm->create_compiler();\n\t\texit_code = runtime::configure_context(config, env, vm, unit) ? (int)exit_status::OK : (int)exit_status::compiler_error;\n\t\tif (exit_code != (int)exit_status::OK)\n\t\t\tgoto finish_program;\n\n\t\truntime::configure_system(config);\n\t\tif (!unit->prepare(env.library))\n\t\t{\n\t\t\tVI_ERR(\"cannot prepare <%s> module scope\", env.library);\n\t\t\texit_code = (int)exit_status::prepare_error;\n\t\t\tgoto finish_program;\n\t\t}\n\n\t\tbyte_code_info info;\n\t\tinfo.data.insert(info.data.begin(), env.program.begin(), env.program.end());\n\t\tif (!unit->load_byte_code(&info).get())\n\t\t{\n\t\t\tVI_ERR(\"cannot load <%s> module bytecode\", env.library);\n\t\t\texit_code = (int)exit_status::loading_error;\n\t\t\tgoto finish_program;\n\t\t}\n\n\t\tprogram_entrypoint entrypoint;\n\t\tfunction main = runtime::get_entrypoint(env, entrypoint, unit);\n\t\tif (!main.is_valid())\n\t\t{\n\t\t\texit_code = (int)exit_status::entrypoint_error;\n\t\t\tgoto finish_program;\n\t\t}\n\n\t\tint exit_code =";
-		dc_executable_program_cpp += " 0;\n\t\tauto type = vm->get_type_info_by_decl(\"array<string>@\");\n\t\tbindings::array* args_array = type.is_valid() ? bindings::array::compose<string>(type.get_type_info(), args) : nullptr;\n\t\tvm->set_exception_callback(&runtime::context_thrown);\n\n\t\tmain.add_ref();\n\t\tloop = new event_loop();\n\t\tloop->listen(context);\n\t\tloop->enqueue(function_delegate(main, context), [&main, args_array](immediate_context* context)\n\t\t{\n\t\t\truntime::startup_environment(environment_config::get());\n\t\t\tif (main.get_args_count() > 0)\n\t\t\t\tcontext->set_arg_object(0, args_array);\n\t\t}, [&exit_code, &type, &main, args_array](immediate_context* context)\n\t\t{\n\t\t\texit_code = main.get_return_type_id() == (int)type_id::void_t ? 0 : (int)context->get_return_dword();\n\t\t\tif (args_array != nullptr)\n\t\t\t\tcontext->get_vm()->release_object(args_array, type);\n\t\t\truntime::shutdown_environment(environment_config::get());\n\t\t\tloop->wakeup();\n\t\t});\n\n\t\truntime::await_context(mutex, loop, vm, context);\n\t}\nfinish_program:\n\tmemory::release(context);\n\tmemory::release(unit);\n\tmemory::release(vm);\n\tmemory::release(loop);\n\treturn exit_code;\n}";
+		dc_executable_program_cpp.reserve(6734);
+		dc_executable_program_cpp += "#include \"runtime.hpp\"\n#include <vengeance/vengeance.h>\n#include <vengeance/bindings.h>\n#include <vengeance/layer.h>\n#include <signal.h>\n#ifdef _MSC_VER\n#include <windows.h>\n#elif defined(HAS_PROGRAM_BYTECODE)\nextern \"C\" const uint8_t program_bytecode_data[];\nextern \"C\" const uint8_t program_bytecode_end[];\n#endif\n\nusing namespace vitex::layer;\nusing namespace asx;\n\n#ifdef HAS_PROGRAM_AOT\nextern const aot_function program_aot_functions[];\nextern const size_t program_aot_functions_count;\naot_compiler native_code(program_aot_functions, program_aot_functions_count);\n#endif\nevent_loop* loop = nullptr;\nvirtual_machine* vm = nullptr;\ncompiler* unit = nullptr;\nimmediate_context* context = nullptr;\nstd::mutex mutex;\nint exit_code = 0;\n\nvoid exit_program(int sigv)\n{\n\tif (sigv != SIGINT && sigv != SIGTERM)\n\t\treturn;\n\n\tnative_completions::get().stop();\n\tumutex<std::mutex> unique(mutex);\n\t{\n\t\tif (runtime::try_context_exit(environment_config::get(), sigv))\n\t\t{\n\t\t\tloop->wakeup();\n\t\t\tgoto graceful_shutdown;\n\t\t}\n\n\t\tauto* app = application::get();\n\t\tif (app != nullptr && app->get_state() == application_state::active)\n\t\t{\n\t\t\tapp->stop();\n\t\t\tloop->wakeup();\n\t\t\tgoto graceful_shutdown;\n\t\t}\n\n\t\tif (schedule::is_available())\n\t\t{\n\t\t\tschedule::get()->stop();\n\t\t\tloop->wakeup();\n\t\t\tgoto graceful_shutdown;\n\t\t}\n\n\t\treturn std::exit((int)exit_status::kill);\n\t}\ngraceful_shutdown:\n\tsignal(sigv, &exit_program);\n}\nvoid setup_program(environment_config& env)\n{\n\tos::directory::set_working(env.path.c_str());\n\tsignal(SIGINT, &exit_program);\n\tsignal(SIGTERM, &exit_program);\n#ifdef VI_UNIX\n\tsignal(SIGPIPE, SIG_IGN);\n\tsignal(SIGCHLD, SIG_IGN);\n#endif\n}\nbool load_program(byte_code_info& info)\n{\n#if defined(HAS_PROGRAM_BYTECODE) && defined(_MSC_VER)\n\tHRSRC resource = FindResource(nullptr, TEXT(\"PROGRAM_BYTECODE\"), RT_RCDATA);\n\tHGLOBAL handle = resource ? LoadResource(nullptr, resource) : nullptr;\n\tconst uint8_t* buffer = handle ? (const uint8_t*)LockResource(handle) : nullptr;\n\tif (!buffer)\n\t\treturn false;\n\n\tinfo.data.insert(info.data.begin(), buffer, buffer + SizeofResource(nullptr, resource));\n\treturn true;\n#elif defined(HAS_PROGRAM_BYTECODE)\n\tinfo.data.insert(info.data.begin(), program_bytecode_data, program_bytecode_end);\n\treturn true;\n#else\n\treturn false;\n#endif\n}\nint main(int argc, char* argv[])\n{\n\tconst char* workers = std::getenv(\"ASX_WORKERS\");\n\tif (workers != nullptr && runtime::spawn_workers(from_string<uint32_t>(workers).or_else(0), exit_code))\n\t\treturn exit_code;\n\n\tenvironment_config env;\n\tenv.profiler.start(std::getenv(\"ASX_PROFILE_STARTUP\"));\n\tenv.path = *os::directory::get_module();\n\tenv.library = argc > 0 ? argv[0] : \"runtime\";\n\tenv.auto_schedule = {{BUILDER_ENV_AUTO_SCHEDULE}};\n\tenv.auto_console = {{BUILDER_ENV_AUTO_CONSOLE}};\n\tenv.auto_stop = {{BUILDER_ENV_AUTO_STOP}};\n\tenv.gc.pause = {{BUILDER_ENV_GC_PAUSE}};\n\tenv.gc.growth = {{BUILDER_ENV_GC_GROWTH}};\n\tenv.gc.interval = {{BUILDER_ENV_GC_INTERVAL}};\n\tenv.gc.adaptive = {{BUILDER_ENV_GC_ADAPTIVE}};\n\tenv.gc_stats.report = std::getenv(\"ASX_GC_STATS\") != nullptr;\n\tenv.profile = std::getenv(\"ASX_PROFILE\") ? std::getenv(\"ASX_PROFILE\") : \"\";\n\tenv.profile_frequency = std::getenv(\"ASX_PROFILE_FREQUENCY\") ? from_string<uint32_t>(std::getenv(\"ASX_PROFILE_FREQUENCY\")).or_else(99) : 99;\n\n\tbyte_code_info info;\n\tif (!load_program(info))\n\t\treturn 0;\n\n\tenv.profiler.record(\"load_program\");\n\tvector<string> args;\n\targs.reserve((size_t)argc);\n\tfor (int i = 0; i < argc; i++)\n\t\targs.push_back(argv[i]);\n\n\tsystem_config config;\n\tconfig.permissions = { {{BUILDER_CONFIG_PERMISSIONS}} };\n\tconfig.libraries = { {{BUILDER_CONFIG_LIBRARIES}} };\n\tconfig.functions = { {{BUILDER_CONFIG_FUNCTIONS}} };\n\tconfig.system_addons = { {{BUILDER_CONFIG_ADDONS}} };\n\tconfig.tags = {{BUILDER_CONFIG_TAGS}};\n\tconfig.ts_imports = {{BUILDER_CONFIG_TS_IMPORTS}};\n\tconfig.essentials_only = {{BUILDER_CONFIG_ESSENTIALS_ONLY}};\n\tconfig.save_source_code = {{BUILDER_CONFIG_SAVE_SOURCE_CODE}};\n\tconfig.full_stack_tracing = {{BUILDER_CONFIG_FULL_STACK_TRACING}};\n\tsetup_program(env);\n\n\tsize_t modules = {{BUILDER_CONFIG_MODULES}};\n\tif (!config.essentials_only)";
+		dc_executable_program_cpp += "\n\t\tmodules |= vitex::use_platform | vitex::use_audio | vitex::use_graphics;\n\n\tvitex::heavy_runtime scope(modules);\n\t{\n\t\tenv.profiler.record(\"runtime\");\n\t\tvm = new virtual_machine();\n\t\tbindings::heavy_registry().bind_addons(vm);\n\t\tenv.profiler.record(\"bind_addons\");\n\t\tunit = vm->create_compiler();\n\t\tcontext = vm->request_context();\n\n\t\tvector<std::pair<uint32_t, size_t>> settings = { {{BUILDER_CONFIG_SETTINGS}} };\n\t\tfor (auto& item : settings)\n\t\t\tvm->set_property((features)item.first, item.second);\n#ifdef HAS_PROGRAM_AOT\n\t\tvm->get_engine()->SetJITCompiler(&native_code);\n#endif\n\n\t\tunit = vm->create_compiler();\n\t\texit_code = runtime::configure_context(config, env, vm, unit) ? (int)exit_status::OK : (int)exit_status::compiler_error;\n\t\tif (exit_code != (int)exit_status::OK)\n\t\t\tgoto finish_program;\n\n\t\tenv.profiler.record(\"configure_context\");\n\t\truntime::configure_system(config);\n\t\tif (!unit->prepare(env.library))\n\t\t{\n\t\t\tVI_ERR(\"cannot prepare <%s> module scope\", env.library);\n\t\t\texit_code = (int)exit_status::prepare_error;\n\t\t\tgoto finish_program;\n\t\t}\n\n\t\tenv.profiler.record(\"prepare\");\n\t\tif (!unit->load_byte_code(&info).get())\n\t\t{\n\t\t\tVI_ERR(\"cannot load <%s> module bytecode\", env.library);\n\t\t\texit_code = (int)exit_status::loading_error;\n\t\t\tgoto finish_program;\n\t\t}\n\n\t\tenv.profiler.record(\"load_byte_code\");\n\t\tprogram_entrypoint entrypoint;\n\t\tfunction main = runtime::get_entrypoint(env, entrypoint, unit);\n\t\tif (!main.is_valid())\n\t\t{\n\t\t\texit_code = (int)exit_status::entrypoint_error;\n\t\t\tgoto finish_program;\n\t\t}\n\n\t\tint exit_code = 0;\n\t\tauto type = vm->get_type_info_by_decl(\"array<string>@\");\n\t\tbindings::array* args_array = type.is_valid() ? bindings::array::compose<string>(type.get_type_info(), args) : nullptr;\n\t\tvm->set_exception_callback(&runtime::context_thrown);\n\n\t\tmain.add_ref();\n\t\tloop = new event_loop();\n\t\tloop->listen(context);\n\t\tloop->enqueue(function_delegate(main, context), [&main, args_array](immediate_context* context)\n\t\t{\n\t\t\truntime::startup_environment(environment_config::get());\n\t\t\tif (main.get_args_count() > 0)\n\t\t\t\tcontext->set_arg_object(0, args_array);\n\t\t}, [&exit_code, &type, &main, args_array](immediate_context* context)\n\t\t{\n\t\t\texit_code = main.get_return_type_id() == (int)type_id::void_t ? 0 : (int)context->get_return_dword();\n\t\t\tif (args_array != nullptr)\n\t\t\t\tcontext->get_vm()->release_object(args_array, type);\n\t\t\truntime::shutdown_environment(environment_config::get());\n\t\t\tloop->wakeup();\n\t\t});\n\n\t\truntime::await_context(mutex, loop, vm, context);\n\t}\nfinish_program:\n\tmemory::release(context);\n\tmemory::release(unit);\n\tmemory::release(vm);\n\tmemory::release(loop);\n\treturn exit_code;\n}";
 		callback(context, "executable/program.cpp", dc_executable_program_cpp.c_str(), (unsigned int)dc_executable_program_cpp.size());
 
 		std::string dc_executable_runtime_hpp;
-		dc_executable_runtime_hpp.reserve(8114);
-		dc_executable_runtime_hpp += "#ifndef RUNTIME_H\n#define RUNTIME_H\n#include <vengeance/bindings.h>\n#include <vengeance/vengeance.h>\n\nusing namespace vitex::core;\nusing namespace vitex::compute;\nusing namespace vitex::scripting;\n\nnamespace asx\n{\n\tenum class exit_status\n\t{\n\t\tnext = 0x00fffff - 1,\n\t\tok = 0,\n\t\truntime_error,\n\t\tprepare_error,\n\t\tloading_error,\n\t\tsaving_error,\n\t\tcompiler_error,\n\t\tentrypoint_error,\n\t\tinput_error,\n\t\tinvalid_command,\n\t\tinvalid_declaration,\n\t\tcommand_error,\n\t\tkill\n\t};\n\n\tstruct program_entrypoint\n\t{\n\t\tconst char* returns_with_args = \"int main(array<string>@)\";\n\t\tconst char* returns = \"int main()\";\n\t\tconst char* simple = \"void main()\";\n\t};\n\n\tstruct environment_config\n\t{\n\t\tinline_args commandline;\n\t\tunordered_set<string> addons;\n\t\tfunction_delegate at_exit;\n\t\tfile_entry file;\n\t\tstring name;\n\t\tstring path;\n\t\tstring program;\n\t\tstring registry;\n\t\tstring mode;\n\t\tstring output;\n\t\tstring addon;\n\t\tcompiler* this_compiler;\n\t\tconst char* library;\n\t\tint32_t auto_schedule;\n\t\tbool auto_console;\n\t\tbool auto_stop;\n\t\tbool inlined;\n\n\t\tenvironment_config() : this_compiler(nullptr), library(\"__anonymous__\"), auto_schedule(-1), auto_console(false), auto_stop(false), inlined(true)\n\t\t{\n\t\t}\n\t\tvoid parse(int args_count, char** args_data, const unordered_set<string>& flags = { })\n\t\t{\n\t\t\tcommandline = os::process::parse_args(args_count, args_data, (size_t)args_format::key_value | (size_t)args_format::flag_value | (size_t)args_format::stop_if_no_match, flags);\n\t\t}\n\t\tstatic environment_config& get(environment_config* other = nullptr)\n\t\t{\n\t\t\tstatic environment_config* base = other;\n\t\t\tVI_ASSERT(base != nullptr, \"env was not set\");\n\t\t\treturn *base;\n\t\t}\n\t};\n\n\tstruct system_config\n\t{\n\t\tunordered_map<string, std::pair<string, string>> functions;\n\t\tunordered_map<access_option, bool> permissions;\n\t\tvector<std::pair<string, bool>> libraries;\n\t\tvector<std::pair<string, int32_t>> settings;\n\t\tvector<string> system_addons;\n\t\tbool ts_imports = true;\n\t\tbool tags = true;\n\t\tbool debug = false;\n\t\tbool interactive = false;\n\t\tbool essentials_only = true;\n\t\tbool load_byte_code = false;\n\t\tbool save_byte_code = false;\n\t\tbool save_source_code = false;\n\t\tbool full_stack_tracing = true;\n\t\tbool dependencies = false;\n\t\tbool install = false;\n\t\tsize_t installed = 0;\n\t};\n\n\tclass runtime\n\t{\n\tpublic:\n\t\tstatic void startup_environment(environment_config& env)\n\t\t{\n\t\t\tif (env.auto_schedule >= 0)\n\t\t\t\tschedule::get()->start(env.auto_schedule > 0 ? schedule::desc((size_t)env.auto_schedule) : schedule::desc());\n\n\t\t\tif (env.auto_console)\n\t\t\t\tconsole::get()->attach();\n\t\t}\n\t\tstatic void shutdown_environment(environment_config& env)\n\t\t{\n\t\t\tif (env.auto_stop)\n\t\t\t\tschedule::get()->stop();\n\t\t}\n\t\tstatic void configure_system(system_config& config)\n\t\t{\n\t\t\tfor (auto& option : config.permissions)\n\t\t\t\tos::control::set(option.first, option.second);\n\t\t}\n\t\tstatic bool configure_context(system_config& config, environment_config& env, virtual_machine* vm, compiler* this_compiler)\n\t\t{\n\t\t\tvm->set_ts_imports(config.ts_imports);\n\t\t\tvm->set_module_directory(os::path::get_directory(env.path.c_str()));\n\t\t\tvm->set_preserve_source_code(config.save_source_code);\n\t\t\tvm->set_full_stack_tracing(config.full_stack_tracing);\n\n\t\t\tfor (auto& name : config.system_addons)\n\t\t\t{\n\t\t\t\tif (!vm->import_system_addon(name))\n\t\t\t\t{\n\t\t\t\t\tVI_ERR(\"%s import error: not found\", name.c_str());\n\t\t\t\t\treturn false;\n\t\t\t\t}\n\t\t\t}\n\n\t\t\tfor (auto& path : config.libraries)\n\t\t\t{\n\t\t\t\tif (!vm->import_clibrary(path.first, path.second))\n\t\t\t\t{\n\t\t\t\t\tVI_ERR(\"%s import error: %s not found\", path.second ? \"addon\" : \"clibrary\", path.first.c_str());\n\t\t\t\t\treturn false;\n\t\t\t\t}\n\t\t\t}\n\n\t\t\tfor (auto& data : config.functions)\n\t\t\t{\n\t\t\t\tif (!vm->import_cfunction({ data.first }, data.second.first, data.second.second))\n\t\t\t\t{\n\t\t\t\t\tVI_ERR(\"%s import error: %s not found\", data.second.first.c_str(), data.first.c_str());\n\t\t\t\t\treturn false;\n\t\t\t\t}\n\t\t\t}\n\n\t\t\tauto* macro = this_compiler->get_processor();\n\t\t\tmacro->add_default_definitions();\n\n\t\t\tenv.this_compiler = this_compiler;\n\t\t\tbindings::tags::bind_syntax(vm, config.tags, &runtime::process_tags);\n\t\t\tenvironment_config::get(&env);\n\n\t\t\tvm->";
-		dc_executable_runtime_hpp += "import_system_addon(\"ctypes\");\n\t\t\tvm->begin_namespace(\"this_process\");\n\t\t\tvm->set_function_def(\"void exit_event(int)\");\n\t\t\tvm->set_function(\"void before_exit(exit_event@)\", &runtime::apply_context_exit);\n\t\t\tvm->set_function(\"uptr@ get_compiler()\", &runtime::get_compiler);\n\t\t\tvm->end_namespace();\n\t\t\treturn true;\n\t\t}\n\t\tstatic bool try_context_exit(environment_config& env, int value)\n\t\t{\n\t\t\tif (!env.at_exit.is_valid())\n\t\t\t\treturn false;\n\n\t\t\tauto status = env.at_exit([value](immediate_context* context)\n\t\t\t{\n\t\t\t\tcontext->set_arg32(0, value);\n\t\t\t}).get();\n\t\t\tenv.at_exit.release();\n\t\t\tvirtual_machine::cleanup_this_thread();\n\t\t\treturn !!status;\n\t\t}\n\t\tstatic void apply_context_exit(asIScriptFunction* callback)\n\t\t{\n\t\t\tauto& env = environment_config::get();\n\t\t\tuptr<immediate_context> context = callback ? env.this_compiler->get_vm()->request_context() : nullptr;\n\t\t\tenv.at_exit = function_delegate(callback, *context);\n\t\t}\n\t\tstatic void await_context(std::mutex& mutex, event_loop* loop, virtual_machine* vm, immediate_context* context)\n\t\t{\n\t\t\tevent_loop::set(loop);\n\t\t\twhile (loop->poll_extended(context, 1000))\n\t\t\t{\n\t\t\t\tvm->perform_periodic_garbage_collection(60000);\n\t\t\t\tloop->dequeue(vm);\n\t\t\t}\n\n\t\t\tumutex<std::mutex> unique(mutex);\n\t\t\tif (schedule::has_instance())\n\t\t\t{\n\t\t\t\tauto* queue = schedule::get();\n\t\t\t\twhile (!queue->can_enqueue() && queue->has_any_tasks())\n\t\t\t\t\tqueue->dispatch();\n\t\t\t\tschedule::cleanup_instance();\n\t\t\t}\n\n\t\t\tevent_loop::set(nullptr);\n\t\t\tcontext->reset();\n\t\t\tvm->perform_full_garbage_collection();\n\t\t\tapply_context_exit(nullptr);\n\t\t}\n\t\tstatic void context_thrown(immediate_context* context)\n\t\t{\n\t\t\tif (context->will_exception_be_caught())\n\t\t\t\treturn;\n\n\t\t\tauto exception = bindings::exception::pointer();\n\t\t\texception.load_exception_data(context->get_exception_string());\n\t\t\texception.context = context;\n\n\t\t\tauto& type = exception.get_type();\n\t\t\tauto& text = exception.get_text();\n\t\t\tVI_PANIC(false, \"%s - %s\", type.empty() ? \"unknown_error\" : type.c_str(), text.empty() ? \"no description available\" : text.c_str());\n\t\t}\n\t\tstatic function get_entrypoint(environment_config& env, program_entrypoint& entrypoint, compiler* unit, bool silent = false)\n\t\t{\n\t\t\tfunction main_returns_with_args = unit->get_module().get_function_by_decl(entrypoint.returns_with_args);\n\t\t\tfunction main_returns = unit->get_module().get_function_by_decl(entrypoint.returns);\n\t\t\tfunction main_simple = unit->get_module().get_function_by_decl(entrypoint.simple);\n\t\t\tif (main_returns_with_args.is_valid() || main_returns.is_valid() || main_simple.is_valid())\n\t\t\t\treturn main_returns_with_args.is_valid() ? main_returns_with_args : (main_returns.is_valid() ? main_returns : main_simple);\n\n\t\t\tif (!silent)\n\t\t\t\tVI_ERR(\"%s module error: function \\\"%s\\\", \\\"%s\\\" or \\\"%s\\\" must be present\", env.library, entrypoint.returns_with_args, entrypoint.returns, entrypoint.simple);\n\t\t\treturn function(nullptr);\n\t\t}\n\t\tstatic compiler* get_compiler()\n\t\t{\n\t\t\treturn environment_config::get().this_compiler;\n\t\t}\n\n\tprivate:\n\t\tstatic void process_tags(virtual_machine* vm, bindings::tags::tag_info&& info)\n\t\t{\n\t\t\tauto& env = environment_config::get();\n\t\t\tfor (auto& tag : info)\n\t\t\t{\n\t\t\t\tif (tag.name != \"main\")\n\t\t\t\t\tcontinue;\n\n\t\t\t\tfor (auto& directive : tag.directives)\n\t\t\t\t{\n\t\t\t\t\tif (directive.name == \"#schedule::main\")\n\t\t\t\t\t{\n\t\t\t\t\t\tauto threads = directive.args.find(\"threads\");\n\t\t\t\t\t\tif (threads != directive.args.end())\n\t\t\t\t\t\t\tenv.auto_schedule = from_string<uint8_t>(threads->second).or_else(0);\n\t\t\t\t\t\telse\n\t\t\t\t\t\t\tenv.auto_schedule = 0;\n\n\t\t\t\t\t\tauto stop = directive.args.find(\"stop\");\n\t\t\t\t\t\tif (stop != directive.args.end())\n\t\t\t\t\t\t{\n\t\t\t\t\t\t\tstringify::to_lower(threads->second);\n\t\t\t\t\t\t\tauto value = from_string<uint8_t>(threads->second);\n\t\t\t\t\t\t\tif (!value)\n\t\t\t\t\t\t\t\tenv.auto_stop = (threads->second == \"on\" || threads->second == \"true\" || threads->second == \"yes\");\n\t\t\t\t\t\t\telse\n\t\t\t\t\t\t\t\tenv.auto_stop = *value > 0;\n\t\t\t\t\t\t}\n\t\t\t\t\t}\n\t\t\t\t\telse if (directive.name == \"#console::main\")\n\t\t\t\t\t\tenv.auto_console = true;\n\t\t\t\t}\n\t\t\t}\n\t\t}\n\t};\n}\n#endif\n";
+		dc_executable_runtime_hpp.reserve(38877);
+		dc_executable_runtime_hpp += "#ifndef RUNTIME_H\n#define RUNTIME_H\n#include <vengeance/bindings.h>\n#include <vengeance/vengeance.h>\n#include <chrono>\n#include <atomic>\n#include <condition_variable>\n#include <thread>\n#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))\n#include <malloc.h>\n#define ASX_HEAP_USAGE\n#endif\n#ifdef VI_UNIX\n#include <sys/socket.h>\n#include <sys/mman.h>\n#include <sys/resource.h>\n#include <sys/time.h>\n#include <sys/wait.h>\n#include <signal.h>\n#include <dlfcn.h>\n#include <unistd.h>\n#endif\n\nusing namespace vitex::core;\nusing namespace vitex::compute;\nusing namespace vitex::scripting;\n\nnamespace asx\n{\n\tenum class exit_status\n\t{\n\t\tnext = 0x00fffff - 1,\n\t\tok = 0,\n\t\truntime_error,\n\t\tprepare_error,\n\t\tloading_error,\n\t\tsaving_error,\n\t\tcompiler_error,\n\t\tentrypoint_error,\n\t\tinput_error,\n\t\tinvalid_command,\n\t\tinvalid_declaration,\n\t\tcommand_error,\n\t\tkill\n\t};\n\n\tstruct program_entrypoint\n\t{\n\t\tconst char* returns_with_args = \"int main(array<string>@)\";\n\t\tconst char* returns = \"int main()\";\n\t\tconst char* simple = \"void main()\";\n\t};\n\n\tstruct startup_profiler\n\t{\n\t\tstruct phase\n\t\t{\n\t\t\tstring name;\n\t\t\tint64_t nanoseconds;\n\t\t\tint64_t retained_bytes;\n\t\t\tint64_t peak_rss_kb;\n\t\t};\n\n\t\tvector<phase> phases;\n\t\tstd::chrono::steady_clock::time_point origin;\n\t\tstd::chrono::steady_clock::time_point time;\n\t\tstring output;\n\t\tint64_t retained = 0;\n\t\tbool active = false;\n\n\t\tvoid start(const char* target)\n\t\t{\n\t\t\tif (!target)\n\t\t\t\treturn;\n\n\t\t\tactive = true;\n\t\t\toutput = strcmp(target, \"1\") != 0 ? target : \"\";\n\t\t\torigin = time = std::chrono::steady_clock::now();\n\t\t\tretained = get_retained_bytes();\n\t\t}\n\t\tvoid record(const std::string_view& name)\n\t\t{\n\t\t\tif (!active)\n\t\t\t\treturn;\n\n\t\t\tauto next_time = std::chrono::steady_clock::now();\n\t\t\tint64_t next_retained = get_retained_bytes();\n\t\t\tphases.push_back({ string(name), (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(next_time - time).count(), next_retained - retained, get_peak_rss_kb() });\n\t\t\ttime = next_time;\n\t\t\tretained = next_retained;\n\t\t}\n\t\tvoid finish()\n\t\t{\n\t\t\tif (!active)\n\t\t\t\treturn;\n\n\t\t\tuptr<schema> data = var::set::object();\n\t\t\tschema* items = data->set(\"phases\", var::set::array());\n\t\t\tfor (auto& item : phases)\n\t\t\t{\n\t\t\t\tschema* next = items->push(var::set::object());\n\t\t\t\tnext->set(\"name\", var::string(item.name));\n\t\t\t\tnext->set(\"nanoseconds\", var::integer(item.nanoseconds));\n\t\t\t\tnext->set(\"retained_bytes\", var::integer(item.retained_bytes));\n\t\t\t\tnext->set(\"peak_rss_kb\", var::integer(item.peak_rss_kb));\n\t\t\t}\n\t\t\tdata->set(\"total_nanoseconds\", var::integer((int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(time - origin).count()));\n\n\t\t\tactive = false;\n\t\t\tstring result = schema::to_json(*data);\n\t\t\tif (output.empty())\n\t\t\t\tfprintf(stderr, \"%s\\n\", result.c_str());\n\t\t\telse if (!os::file::write(output, (uint8_t*)result.data(), result.size()))\n\t\t\t\tVI_ERR(\"%s profile error: write failed\", output.c_str());\n\t\t}\n\t\tstatic int64_t get_peak_rss_kb()\n\t\t{\n#ifdef VI_UNIX\n\t\t\tstruct rusage usage;\n\t\t\tmemset(&usage, 0, sizeof(usage));\n\t\t\tif (getrusage(RUSAGE_SELF, &usage) != 0)\n\t\t\t\treturn 0;\n#ifdef __APPLE__\n\t\t\treturn (int64_t)usage.ru_maxrss / 1024;\n#else\n\t\t\treturn (int64_t)usage.ru_maxrss;\n#endif\n#else\n\t\t\treturn 0;\n#endif\n\t\t}\n\t\tstatic int64_t get_retained_bytes()\n\t\t{\n\t\t\t/* bytes held by malloc heap right now, a difference of two calls is net growth and not a count of allocations */\n#ifdef ASX_HEAP_USAGE\n\t\t\treturn (int64_t)mallinfo2().uordblks;\n#else\n\t\t\treturn 0;\n#endif\n\t\t}\n\t};\n\n\tstruct gc_policy\n\t{\n\t\tstd::chrono::steady_clock::time_point collected = std::chrono::steady_clock::now();\n\t\tuint64_t pause = 2000;\n\t\tuint64_t growth = 1024;\n\t\tuint64_t interval = 60000;\n\t\tuint32_t baseline = 0;\n\t\tbool adaptive = true;\n\t\tbool pending = false;\n\n\t\tbool configure(const std::string_view& name, const std::string_view& value)\n\t\t{\n\t\t\tauto numeric = from_string<uint64_t>(value);\n\t\t\tif (name == \"adaptive\")\n\t\t\t{\n\t\t\t\tif (numeric)\n\t\t\t\t\tadaptive = *numeric > 0;\n\t\t\t\telse if (value == \"on\" || value == \"true\" || value == \"yes\")\n\t\t\t\t\tadaptive = true;\n\t\t\t\telse if (value == \"off\" || value == \"false\" || value ==";
+		dc_executable_runtime_hpp += " \"no\")\n\t\t\t\t\tadaptive = false;\n\t\t\t\telse\n\t\t\t\t\treturn false;\n\n\t\t\t\treturn true;\n\t\t\t}\n\t\t\telse if (!numeric)\n\t\t\t\treturn false;\n\n\t\t\tif (name == \"pause\")\n\t\t\t\tpause = *numeric;\n\t\t\telse if (name == \"growth\")\n\t\t\t\tgrowth = *numeric;\n\t\t\telse if (name == \"interval\")\n\t\t\t\tinterval = *numeric;\n\t\t\telse\n\t\t\t\treturn false;\n\n\t\t\treturn true;\n\t\t}\n\t};\n\n\tstruct gc_statistics\n\t{\n\t\tstd::chrono::steady_clock::time_point time;\n\t\tuint64_t collections = 0;\n\t\tuint64_t nanoseconds = 0;\n\t\tuint64_t max_nanoseconds = 0;\n\t\tuint64_t scanned = 0;\n\t\tuint64_t freed = 0;\n\t\tuint64_t detected = 0;\n\t\tasUINT destroyed_before = 0;\n\t\tasUINT detected_before = 0;\n\t\tbool cycle = false;\n\t\tbool report = false;\n\n\t\tvoid begin(asIScriptEngine* engine)\n\t\t{\n\t\t\tasUINT size = 0, destroyed = 0, new_destroyed = 0;\n\t\t\tengine->GetGCStatistics(&size, &destroyed, &detected_before, nullptr, &new_destroyed);\n\t\t\tdestroyed_before = destroyed + new_destroyed;\n\t\t\tif (!cycle)\n\t\t\t{\n\t\t\t\t/* incremental steps of one cycle walk the same set of objects */\n\t\t\t\tscanned += size;\n\t\t\t\tcycle = true;\n\t\t\t}\n\t\t\ttime = std::chrono::steady_clock::now();\n\t\t}\n\t\tvoid end(asIScriptEngine* engine, bool completed)\n\t\t{\n\t\t\tuint64_t delta = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time).count();\n\t\t\tasUINT destroyed = 0, new_destroyed = 0, detected_after = 0;\n\t\t\tengine->GetGCStatistics(nullptr, &destroyed, &detected_after, nullptr, &new_destroyed);\n\t\t\tfreed += (uint64_t)(destroyed + new_destroyed - destroyed_before);\n\t\t\tdetected += (uint64_t)(detected_after - detected_before);\n\t\t\tmax_nanoseconds = std::max(max_nanoseconds, delta);\n\t\t\tnanoseconds += delta;\n\t\t\tif (!completed)\n\t\t\t\treturn;\n\n\t\t\tcycle = false;\n\t\t\t++collections;\n\t\t}\n\t\tvoid print(asIScriptEngine* engine)\n\t\t{\n\t\t\tasUINT size = 0, new_objects = 0;\n\t\t\tengine->GetGCStatistics(&size, nullptr, nullptr, &new_objects, nullptr);\n\t\t\tfprintf(stderr, \"gc: %\" PRIu64 \" collections, %.3fms total, %.3fms max pause, %\" PRIu64 \" scanned, %\" PRIu64 \" freed, %\" PRIu64 \" cycles detected, %u live objects (%u new)\\n\",\n\t\t\t\tcollections, (double)nanoseconds / 1000000.0, (double)max_nanoseconds / 1000000.0, scanned, freed, detected, (uint32_t)size, (uint32_t)new_objects);\n\t\t}\n\t};\n\n\tstruct shared_buffer\n\t{\n\t\tuint8_t* data = nullptr;\n\t\tsize_t size = 0;\n\t\tshared_buffer* parent = nullptr;\n\t\tvoid(*release_callback)(void* data, void* context) = nullptr;\n\t\tvoid* release_context = nullptr;\n\t\tstd::atomic<int32_t> references = 1;\n\n\t\tvoid add_ref()\n\t\t{\n\t\t\t++references;\n\t\t}\n\t\tvoid release()\n\t\t{\n\t\t\tif (--references > 0)\n\t\t\t\treturn;\n\n\t\t\tif (parent != nullptr)\n\t\t\t\tparent->release();\n\t\t\telse if (release_callback != nullptr)\n\t\t\t\trelease_callback(data, release_context);\n\t\t\telse\n\t\t\t\tdelete[] data;\n\t\t\tdelete this;\n\t\t}\n\t\tvoid fill(uint8_t value)\n\t\t{\n\t\t\tif (size > 0)\n\t\t\t\tmemset(data, value, size);\n\t\t}\n\t\tvoid copy(uint64_t offset, const shared_buffer& from)\n\t\t{\n\t\t\tif (offset > size || from.size > size - offset)\n\t\t\t\tthrow_exception(\"buffer copy out of range\");\n\t\t\telse if (from.size > 0)\n\t\t\t\tmemmove(data + offset, from.data, from.size);\n\t\t}\n\t\tuint8_t* at(uint64_t index)\n\t\t{\n\t\t\tif (index < size)\n\t\t\t\treturn data + index;\n\n\t\t\tthrow_exception(\"buffer index out of range\");\n\t\t\treturn nullptr;\n\t\t}\n\t\tuint64_t get_size() const\n\t\t{\n\t\t\treturn (uint64_t)size;\n\t\t}\n\t\tshared_buffer* slice(uint64_t offset, uint64_t count)\n\t\t{\n\t\t\tif (offset > size || count > size - offset)\n\t\t\t{\n\t\t\t\tthrow_exception(\"buffer slice out of range\");\n\t\t\t\treturn nullptr;\n\t\t\t}\n\n\t\t\tauto* result = new shared_buffer();\n\t\t\tresult->data = data + offset;\n\t\t\tresult->size = (size_t)count;\n\t\t\tresult->parent = parent ? parent : this;\n\t\t\tresult->parent->add_ref();\n\t\t\treturn result;\n\t\t}\n\t\tstatic shared_buffer* create(uint64_t size)\n\t\t{\n\t\t\tauto* result = new shared_buffer();\n\t\t\tresult->data = size > 0 ? new uint8_t[(size_t)size]() : nullptr;\n\t\t\tresult->size = (size_t)size;\n\t\t\treturn result;\n\t\t}\n\t\tstatic shared_buffer* wrap(void* data, size_t size, void(*release_callback)(void*, void*), void* release_context)\n\t\t{\n\t\t\tauto* result = new shared_buffer();\n\t\t\tresult->data = (uint8_t*)data;\n\t\t\tresult->size = size;\n\t\t\tre";
+		dc_executable_runtime_hpp += "sult->release_callback = release_callback;\n\t\t\tresult->release_context = release_context;\n\t\t\treturn result;\n\t\t}\n\t\tstatic void throw_exception(const char* message)\n\t\t{\n\t\t\tauto* context = asGetActiveContext();\n\t\t\tif (context != nullptr)\n\t\t\t\tcontext->SetException(message);\n\t\t}\n\t\tstatic bool bind(virtual_machine* vm)\n\t\t{\n\t\t\tauto base = vm->set_class_address(\"native_buffer\", sizeof(shared_buffer), (size_t)object_behaviours::ref);\n\t\t\texpects_vm<void> results[] =\n\t\t\t{\n\t\t\t\tbase.set_behaviour_address(\"native_buffer@ f(uint64)\", behaviours::factory, bridge::function(&shared_buffer::create), function_call::cdecl_call),\n\t\t\t\tbase.set_behaviour_address(\"void f()\", behaviours::addref, bridge::method(&shared_buffer::add_ref), function_call::thiscall),\n\t\t\t\tbase.set_behaviour_address(\"void f()\", behaviours::release, bridge::method(&shared_buffer::release), function_call::thiscall),\n\t\t\t\tbase.set_method(\"uint8& opIndex(uint64)\", &shared_buffer::at),\n\t\t\t\tbase.set_method(\"const uint8& opIndex(uint64) const\", &shared_buffer::at),\n\t\t\t\tbase.set_method(\"uint64 size() const\", &shared_buffer::get_size),\n\t\t\t\tbase.set_method(\"native_buffer@ slice(uint64, uint64)\", &shared_buffer::slice),\n\t\t\t\tbase.set_method(\"void fill(uint8)\", &shared_buffer::fill),\n\t\t\t\tbase.set_method(\"void copy(uint64, const native_buffer&in)\", &shared_buffer::copy)\n\t\t\t};\n\n\t\t\tfor (auto& status : results)\n\t\t\t{\n\t\t\t\tif (!status)\n\t\t\t\t{\n\t\t\t\t\tVI_ERR(\"native_buffer binding error: %s\", status.error().what());\n\t\t\t\t\treturn false;\n\t\t\t\t}\n\t\t\t}\n\t\t\treturn true;\n\t\t}\n\t};\n\n\tstruct native_completions\n\t{\n\t\tvector<std::function<void()>> callbacks;\n\t\tstd::condition_variable condition;\n\t\tstd::mutex mutex;\n\t\tevent_loop* loop = nullptr;\n\t\tvoid(*abandon)() = nullptr;\n\t\tsize_t pending = 0;\n\t\tstd::atomic<bool> stopping = false;\n\n\t\tvoid listen(event_loop* target)\n\t\t{\n\t\t\tumutex<std::mutex> unique(mutex);\n\t\t\tloop = target;\n\t\t}\n\t\tvoid begin(void(*abandon_callback)())\n\t\t{\n\t\t\tumutex<std::mutex> unique(mutex);\n\t\t\tabandon = abandon_callback;\n\t\t\t++pending;\n\t\t}\n\t\tvoid push(std::function<void()>&& callback)\n\t\t{\n\t\t\tumutex<std::mutex> unique(mutex);\n\t\t\tcallbacks.push_back(std::move(callback));\n\t\t\tcondition.notify_one();\n\t\t\tif (loop != nullptr)\n\t\t\t\tloop->wakeup();\n\t\t}\n\t\tbool dispatch()\n\t\t{\n\t\t\tvector<std::function<void()>> queue;\n\t\t\t{\n\t\t\t\tumutex<std::mutex> unique(mutex);\n\t\t\t\tqueue.swap(callbacks);\n\t\t\t\tpending -= std::min(pending, queue.size());\n\t\t\t}\n\n\t\t\tfor (auto& callback : queue)\n\t\t\t\tcallback();\n\t\t\treturn !queue.empty();\n\t\t}\n\t\tvoid stop()\n\t\t{\n\t\t\t/* called from signal handlers, waiting loop notices it on timeout at the latest */\n\t\t\tstopping = true;\n\t\t}\n\t\tvoid reject()\n\t\t{\n\t\t\tvoid(*callback)() = nullptr;\n\t\t\t{\n\t\t\t\tumutex<std::mutex> unique(mutex);\n\t\t\t\tif (!pending)\n\t\t\t\t\treturn;\n\n\t\t\t\tcallback = abandon;\n\t\t\t}\n\n\t\t\tif (callback != nullptr)\n\t\t\t\tcallback();\n\t\t\tdispatch();\n\t\t}\n\t\tbool wait(uint64_t timeout)\n\t\t{\n\t\t\tstd::unique_lock<std::mutex> unique(mutex);\n\t\t\tif (!pending || stopping)\n\t\t\t\treturn false;\n\n\t\t\tcondition.wait_for(unique, std::chrono::milliseconds(timeout), [this]() { return !callbacks.empty() || stopping; });\n\t\t\treturn true;\n\t\t}\n\t\tstatic native_completions& get()\n\t\t{\n\t\t\tstatic native_completions base;\n\t\t\treturn base;\n\t\t}\n\t};\n\n\tstruct aot_function\n\t{\n\t\tconst char* declaration;\n\t\tuint64_t hash;\n\t\tasUINT length;\n\t\tasJITFunction callable;\n\t\tconst asUINT* entries;\n\t\tasUINT entries_count;\n\n\t\tstatic uint64_t get_hash(const asDWORD* byte_code, asUINT length)\n\t\t{\n\t\t\t/* operands of interpreted instructions hold process specific pointers and ids, only translated ones are compared in full */\n\t\t\tuint64_t hash = 0xcbf29ce484222325;\n\t\t\tfor (asUINT i = 0; i < length;)\n\t\t\t{\n\t\t\t\tasBYTE op = *(const asBYTE*)(byte_code + i);\n\t\t\t\tasUINT size = (asUINT)asBCTypeSize[asBCInfo[op].type];\n\t\t\t\tif (is_translated(op))\n\t\t\t\t{\n\t\t\t\t\tfor (asUINT j = 0; j < size && i + j < length; j++)\n\t\t\t\t\t\thash = (hash ^ byte_code[i + j]) * 0x100000001b3;\n\t\t\t\t}\n\t\t\t\telse\n\t\t\t\t\thash = (hash ^ op) * 0x100000001b3;\n\t\t\t\ti += size > 0 ? size : 1;\n\t\t\t}\n\t\t\treturn hash;\n\t\t}\n\t\tstatic bool is_translated(asBYTE op)\n\t\t{\n\t\t\tswitch (op)\n\t\t\t{\n\t\t\t\tcase asBC_SUSPEND: case asBC_SetV1: cas";
+		dc_executable_runtime_hpp += "e asBC_SetV2: case asBC_SetV4: case asBC_SetV8:\n\t\t\t\tcase asBC_CpyVtoV4: case asBC_CpyVtoV8: case asBC_CpyVtoR4: case asBC_CpyVtoR8: case asBC_CpyRtoV4: case asBC_CpyRtoV8: case asBC_ClrHi:\n\t\t\t\tcase asBC_CMPi: case asBC_CMPu: case asBC_CMPf: case asBC_CMPd: case asBC_CMPi64: case asBC_CMPu64: case asBC_CMPIi: case asBC_CMPIu: case asBC_CMPIf:\n\t\t\t\tcase asBC_TZ: case asBC_TNZ: case asBC_TS: case asBC_TNS: case asBC_TP: case asBC_TNP:\n\t\t\t\tcase asBC_JMP: case asBC_JZ: case asBC_JNZ: case asBC_JS: case asBC_JNS: case asBC_JP: case asBC_JNP: case asBC_JLowZ: case asBC_JLowNZ:\n\t\t\t\tcase asBC_ADDi: case asBC_SUBi: case asBC_MULi: case asBC_DIVi: case asBC_MODi: case asBC_DIVu: case asBC_MODu:\n\t\t\t\tcase asBC_ADDi64: case asBC_SUBi64: case asBC_MULi64: case asBC_DIVi64: case asBC_MODi64: case asBC_DIVu64: case asBC_MODu64:\n\t\t\t\tcase asBC_ADDf: case asBC_SUBf: case asBC_MULf: case asBC_DIVf: case asBC_MODf:\n\t\t\t\tcase asBC_ADDd: case asBC_SUBd: case asBC_MULd: case asBC_DIVd: case asBC_MODd:\n\t\t\t\tcase asBC_ADDIi: case asBC_SUBIi: case asBC_MULIi: case asBC_ADDIf: case asBC_SUBIf: case asBC_MULIf:\n\t\t\t\tcase asBC_INCVi: case asBC_DECVi: case asBC_NEGi: case asBC_NEGi64: case asBC_NEGf: case asBC_NEGd: case asBC_BNOT: case asBC_BNOT64:\n\t\t\t\tcase asBC_BAND: case asBC_BOR: case asBC_BXOR: case asBC_BAND64: case asBC_BOR64: case asBC_BXOR64:\n\t\t\t\tcase asBC_BSLL: case asBC_BSRL: case asBC_BSRA: case asBC_BSLL64: case asBC_BSRL64: case asBC_BSRA64:\n\t\t\t\t\treturn true;\n\t\t\t\tcase asBC_iTOf: case asBC_fTOi: case asBC_uTOf: case asBC_sbTOi: case asBC_swTOi: case asBC_ubTOi: case asBC_uwTOi:\n\t\t\t\tcase asBC_dTOi: case asBC_dTOf: case asBC_iTOd: case asBC_uTOd: case asBC_fTOd:\n\t\t\t\tcase asBC_i64TOi: case asBC_uTOi64: case asBC_iTOi64: case asBC_fTOi64: case asBC_dTOi64: case asBC_i64TOf: case asBC_i64TOd:\n\t\t\t\t\treturn asBCInfo[op].type == asBCTYPE_rW_ARG || asBCInfo[op].type == asBCTYPE_wW_rW_ARG;\n\t\t\t\tdefault:\n\t\t\t\t\treturn false;\n\t\t\t}\n\t\t}\n\t\tstatic float to_float(asDWORD bits)\n\t\t{\n\t\t\tfloat result;\n\t\t\tmemcpy(&result, &bits, sizeof(result));\n\t\t\treturn result;\n\t\t}\n\t};\n\n\tclass aot_compiler final : public asIJITCompiler\n\t{\n\tprivate:\n\t\tunordered_map<string, const aot_function*> functions;\n\n\tpublic:\n\t\taot_compiler(const aot_function* items, size_t count)\n\t\t{\n\t\t\tfunctions.reserve(count);\n\t\t\tfor (size_t i = 0; i < count; i++)\n\t\t\t\tfunctions[items[i].declaration] = &items[i];\n\t\t}\n\t\tint CompileFunction(asIScriptFunction* function, asJITFunction* output) override\n\t\t{\n\t\t\tauto it = functions.find(function->GetDeclaration(true, true, false));\n\t\t\tif (it == functions.end())\n\t\t\t\treturn asNO_FUNCTION;\n\n\t\t\tasUINT length = 0;\n\t\t\tasDWORD* byte_code = function->GetByteCode(&length);\n\t\t\tconst aot_function* target = it->second;\n\t\t\tif (!byte_code || length != target->length || aot_function::get_hash(byte_code, length) != target->hash)\n\t\t\t{\n\t\t\t\tVI_DEBUG(\"%s aot mismatch: bytecode differs from translated one\", target->declaration);\n\t\t\t\treturn asNO_FUNCTION;\n\t\t\t}\n\n\t\t\t/* entry arguments select a resume point, zero keeps the instruction interpreted */\n\t\t\tfor (asUINT i = 0; i < target->entries_count; i++)\n\t\t\t\t*(asPWORD*)(byte_code + target->entries[i] + 1) = (asPWORD)i + 1;\n\n\t\t\t*output = target->callable;\n\t\t\treturn asSUCCESS;\n\t\t}\n\t\tvoid ReleaseJITFunction(asJITFunction) override\n\t\t{\n\t\t}\n\t};\n\n\tstruct benchmark_target\n\t{\n\t\tstring name;\n\t\tsize_t iterations = 1000;\n\t\tsize_t warmup = 100;\n\t};\n\n\tstruct environment_config\n\t{\n\t\tinline_args commandline;\n\t\tunordered_map<string, std::pair<string, string>> locked_addons;\n\t\tunordered_set<string> addons;\n\t\tunordered_set<string> includes;\n\t\tvector<benchmark_target> benchmarks;\n\t\tvector<string> pending_addons;\n\t\tfunction_delegate at_exit;\n\t\tstartup_profiler profiler;\n\t\tgc_policy gc;\n\t\tgc_statistics gc_stats;\n\t\tfile_entry file;\n\t\tstring name;\n\t\tstring path;\n\t\tstring program;\n\t\tstring registry;\n\t\tstring mode;\n\t\tstring output;\n\t\tstring addon;\n\t\tstring profile;\n\t\tstring bench_output;\n\t\tstring bench_baseline;\n\t\tstring pgo_training;\n\t\tstring mirror;\n\t\tcompiler* this_compiler;\n\t\tconst char* library;\n\t\tuint32_t profile_frequency;\n\t\tint32_t auto_schedule;\n\t\tbool auto_con";
+		dc_executable_runtime_hpp += "sole;\n\t\tbool auto_stop;\n\t\tbool inlined;\n\n\t\tenvironment_config() : this_compiler(nullptr), library(\"__anonymous__\"), profile_frequency(99), auto_schedule(-1), auto_console(false), auto_stop(false), inlined(true)\n\t\t{\n\t\t}\n\t\tvoid parse(int args_count, char** args_data, const unordered_set<string>& flags = { })\n\t\t{\n\t\t\tcommandline = os::process::parse_args(args_count, args_data, (size_t)args_format::key_value | (size_t)args_format::flag_value | (size_t)args_format::stop_if_no_match, flags);\n\t\t}\n\t\tstatic environment_config& get(environment_config* other = nullptr)\n\t\t{\n\t\t\tstatic environment_config* base = other;\n\t\t\tVI_ASSERT(base != nullptr, \"env was not set\");\n\t\t\treturn *base;\n\t\t}\n\t};\n\n\tstruct system_config\n\t{\n\t\tunordered_map<string, std::pair<string, string>> functions;\n\t\tunordered_map<access_option, bool> permissions;\n\t\tvector<std::pair<string, bool>> libraries;\n\t\tvector<std::pair<string, int32_t>> settings;\n\t\tvector<std::pair<string, string>> gc_settings;\n\t\tvector<string> system_addons;\n\t\tbool ts_imports = true;\n\t\tbool tags = true;\n\t\tbool debug = false;\n\t\tbool interactive = false;\n\t\tbool essentials_only = true;\n\t\tbool load_byte_code = false;\n\t\tbool save_byte_code = false;\n\t\tbool save_source_code = false;\n\t\tbool cache = true;\n\t\tbool bench = false;\n\t\tbool full_stack_tracing = true;\n\t\tbool dependencies = false;\n\t\tbool install = false;\n\t\tbool lto = false;\n\t\tbool pgo = false;\n\t\tbool aot = false;\n\t\tsize_t installed = 0;\n\t\tsize_t workers = 0;\n\t\tsize_t jobs = 1;\n\t};\n\n\tclass sampling_profiler\n\t{\n\tpublic:\n\t\tstatic constexpr size_t max_frames = 48;\n\t\tstatic constexpr size_t max_samples = 4096;\n\n\t\tstruct sample\n\t\t{\n\t\t\tstd::atomic<bool> ready = { false };\n\t\t\tint frames[max_frames];\n\t\t\tuint32_t size = 0;\n\t\t};\n\n\t\tstruct state\n\t\t{\n\t\t\tunordered_map<string, uint64_t> stacks;\n\t\t\tsample samples[max_samples];\n\t\t\tstd::atomic<uint64_t> writes = { 0 };\n\t\t\tstd::atomic<uint64_t> dropped = { 0 };\n\t\t\tstd::atomic<bool> dump = { false };\n\t\t\tasIScriptEngine* engine = nullptr;\n\t\t\tuint64_t reads = 0;\n\t\t\tstring output;\n\t\t};\n\n\tpublic:\n\t\tstatic bool start(const std::string_view& output, uint32_t frequency, virtual_machine* vm)\n\t\t{\n#ifdef VI_UNIX\n\t\t\tif (get() != nullptr || !frequency)\n\t\t\t\treturn false;\n\n\t\t\tstate* base = new state();\n\t\t\tbase->output = output;\n\t\t\tbase->engine = vm->get_engine();\n\t\t\tget() = base;\n\n\t\t\tstruct sigaction action;\n\t\t\tmemset(&action, 0, sizeof(action));\n\t\t\taction.sa_handler = &record;\n\t\t\taction.sa_flags = SA_RESTART;\n\t\t\tsigemptyset(&action.sa_mask);\n\t\t\tsigaction(SIGPROF, &action, nullptr);\n\t\t\tsignal(SIGUSR2, [](int) { if (get() != nullptr) get()->dump = true; });\n\n\t\t\tstruct itimerval timer;\n\t\t\ttimer.it_interval.tv_sec = 0;\n\t\t\ttimer.it_interval.tv_usec = (suseconds_t)(1000000 / std::max<uint32_t>(1, std::min<uint32_t>(frequency, 10000)));\n\t\t\ttimer.it_value = timer.it_interval;\n\t\t\tsetitimer(ITIMER_PROF, &timer, nullptr);\n\t\t\treturn true;\n#else\n\t\t\tVI_WARN(\"sampling profiler is not supported on this platform\");\n\t\t\treturn false;\n#endif\n\t\t}\n\t\tstatic void stop()\n\t\t{\n#ifdef VI_UNIX\n\t\t\tstate* base = get();\n\t\t\tif (!base)\n\t\t\t\treturn;\n\n\t\t\tstruct itimerval timer;\n\t\t\tmemset(&timer, 0, sizeof(timer));\n\t\t\tsetitimer(ITIMER_PROF, &timer, nullptr);\n\t\t\tsignal(SIGPROF, SIG_IGN);\n\t\t\tsignal(SIGUSR2, SIG_DFL);\n\t\t\tflush();\n\t\t\tget() = nullptr;\n\t\t\tdelete base;\n#endif\n\t\t}\n\t\tstatic void update()\n\t\t{\n\t\t\tstate* base = get();\n\t\t\tif (!base)\n\t\t\t\treturn;\n\n\t\t\tcollect();\n\t\t\tif (base->dump.exchange(false))\n\t\t\t\tflush();\n\t\t}\n\n\tprivate:\n\t\tstatic void record(int)\n\t\t{\n\t\t\tstate* base = get();\n\t\t\tif (!base)\n\t\t\t\treturn;\n\n\t\t\tauto& item = base->samples[base->writes.fetch_add(1, std::memory_order_relaxed) % max_samples];\n\t\t\tif (item.ready.load(std::memory_order_acquire))\n\t\t\t{\n\t\t\t\tbase->dropped.fetch_add(1, std::memory_order_relaxed);\n\t\t\t\treturn;\n\t\t\t}\n\n\t\t\t/* timer interrupts thread that consumed cpu time, its active context (if any) is read right here without any script hooks */\n\t\t\titem.size = 0;\n\t\t\tasIScriptContext* context = asGetActiveContext();\n\t\t\tif (context != nullptr && context->GetState() == asEXECUTION_ACTIVE)\n\t\t\t{\n\t\t\t\tasUINT size = std::min<asUINT>(context->GetCallstackSize(), ";
+		dc_executable_runtime_hpp += "(asUINT)max_frames);\n\t\t\t\tfor (asUINT i = 0; i < size; i++)\n\t\t\t\t{\n\t\t\t\t\tasIScriptFunction* function = context->GetFunction(i);\n\t\t\t\t\tif (function != nullptr)\n\t\t\t\t\t\titem.frames[item.size++] = function->GetId();\n\t\t\t\t}\n\t\t\t}\n\t\t\titem.ready.store(true, std::memory_order_release);\n\t\t}\n\t\tstatic void collect()\n\t\t{\n\t\t\tstate* base = get();\n\t\t\tuint64_t writes = base->writes.load(std::memory_order_acquire);\n\t\t\tfor (; base->reads < writes; base->reads++)\n\t\t\t{\n\t\t\t\tauto& item = base->samples[base->reads % max_samples];\n\t\t\t\tif (!item.ready.load(std::memory_order_acquire))\n\t\t\t\t\tcontinue;\n\n\t\t\t\tstring stack;\n\t\t\t\tfor (uint32_t i = item.size; i-- > 0;)\n\t\t\t\t{\n\t\t\t\t\tif (!stack.empty())\n\t\t\t\t\t\tstack += ';';\n\n\t\t\t\t\tasIScriptFunction* function = base->engine->GetFunctionById(item.frames[i]);\n\t\t\t\t\tif (!function)\n\t\t\t\t\t{\n\t\t\t\t\t\tstack += \"[unknown]\";\n\t\t\t\t\t\tcontinue;\n\t\t\t\t\t}\n\n\t\t\t\t\tfunction->AddRef();\n\t\t\t\t\tconst char* name_space = function->GetNamespace();\n\t\t\t\t\tconst char* type_name = function->GetObjectName();\n\t\t\t\t\tif (name_space != nullptr && *name_space != '\\0')\n\t\t\t\t\t\tstack.append(name_space).append(\"::\");\n\t\t\t\t\tif (type_name != nullptr)\n\t\t\t\t\t\tstack.append(type_name).append(\"::\");\n\t\t\t\t\tstack += function->GetName();\n\t\t\t\t\tfunction->Release();\n\t\t\t\t}\n\n\t\t\t\t++base->stacks[stack.empty() ? string(\"[native]\") : stack];\n\t\t\t\titem.ready.store(false, std::memory_order_release);\n\t\t\t}\n\t\t}\n\t\tstatic void flush()\n\t\t{\n\t\t\tstate* base = get();\n\t\t\tcollect();\n\n\t\t\tstring data;\n\t\t\tfor (auto& item : base->stacks)\n\t\t\t\tdata += item.first + \" \" + to_string(item.second) + \"\\n\";\n\n\t\t\tif (!os::file::write(base->output, (uint8_t*)data.data(), data.size()))\n\t\t\t\tVI_ERR(\"%s profile error: write failed\", base->output.c_str());\n\t\t\telse if (base->dropped > 0)\n\t\t\t\tVI_WARN(\"%s profile warning: %\" PRIu64 \" samples dropped\", base->output.c_str(), (uint64_t)base->dropped.load());\n\t\t}\n\t\tstatic state*& get()\n\t\t{\n\t\t\tstatic state* base = nullptr;\n\t\t\treturn base;\n\t\t}\n\t};\n\n\tclass runtime\n\t{\n\tpublic:\n\t\tstatic constexpr size_t max_workers = 256;\n\n\tpublic:\n\t\tstatic void startup_environment(environment_config& env)\n\t\t{\n\t\t\tenv.profiler.record(\"entrypoint\");\n\t\t\tenv.profiler.finish();\n\n\t\t\tif (env.auto_schedule >= 0)\n\t\t\t\tschedule::get()->start(env.auto_schedule > 0 ? schedule::desc((size_t)env.auto_schedule) : schedule::desc());\n\n\t\t\tif (env.auto_console)\n\t\t\t\tconsole::get()->attach();\n\t\t}\n\t\tstatic void shutdown_environment(environment_config& env)\n\t\t{\n\t\t\tif (env.auto_stop)\n\t\t\t\tschedule::get()->stop();\n\t\t}\n\t\tstatic void configure_system(system_config& config)\n\t\t{\n\t\t\tfor (auto& option : config.permissions)\n\t\t\t\tos::control::set(option.first, option.second);\n\t\t}\n\t\tstatic bool configure_context(system_config& config, environment_config& env, virtual_machine* vm, compiler* this_compiler)\n\t\t{\n\t\t\tvm->set_ts_imports(config.ts_imports);\n\t\t\tvm->set_module_directory(os::path::get_directory(env.path.c_str()));\n\t\t\tvm->set_preserve_source_code(config.save_source_code);\n\t\t\tvm->set_full_stack_tracing(config.full_stack_tracing);\n\n\t\t\tfor (auto& name : config.system_addons)\n\t\t\t{\n\t\t\t\tif (!vm->import_system_addon(name))\n\t\t\t\t{\n\t\t\t\t\tVI_ERR(\"%s import error: not found\", name.c_str());\n\t\t\t\t\treturn false;\n\t\t\t\t}\n\t\t\t}\n\n\t\t\tfor (auto& path : config.libraries)\n\t\t\t{\n\t\t\t\tif (!vm->import_clibrary(path.first, path.second))\n\t\t\t\t{\n\t\t\t\t\tVI_ERR(\"%s import error: %s not found\", path.second ? \"addon\" : \"clibrary\", path.first.c_str());\n\t\t\t\t\treturn false;\n\t\t\t\t}\n\t\t\t}\n\n\t\t\tfor (auto& data : config.functions)\n\t\t\t{\n\t\t\t\tif (!vm->import_cfunction({ data.first }, data.second.first, data.second.second))\n\t\t\t\t{\n\t\t\t\t\tVI_ERR(\"%s import error: %s not found\", data.second.first.c_str(), data.first.c_str());\n\t\t\t\t\treturn false;\n\t\t\t\t}\n\t\t\t}\n\n\t\t\tauto* macro = this_compiler->get_processor();\n\t\t\tmacro->add_default_definitions();\n\n\t\t\tenv.this_compiler = this_compiler;\n\t\t\tbindings::tags::bind_syntax(vm, config.tags, &runtime::process_tags);\n\t\t\tenvironment_config::get(&env);\n\n\t\t\tvm->import_system_addon(\"ctypes\");\n\t\t\tif (!shared_buffer::bind(vm))\n\t\t\t\treturn false;\n\n\t\t\tvm->begin_namespace(\"this_process\");\n\t\t\tvm->set_function_def(\"void exit_event(int)\");\n\t\t\tvm->set_function(\"void before_ex";
+		dc_executable_runtime_hpp += "it(exit_event@)\", &runtime::apply_context_exit);\n\t\t\tvm->set_function(\"uptr@ get_compiler()\", &runtime::get_compiler);\n\t\t\tvm->set_function(\"bool is_worker()\", &runtime::get_worker);\n\t\t\tvm->set_function(\"bool share_socket(usize)\", &runtime::share_socket);\n\t\t\tvm->end_namespace();\n\t\t\tvm->begin_namespace(\"this_process::gc\");\n\t\t\tvm->set_function(\"uint64 get_collections()\", &runtime::get_gc_collections);\n\t\t\tvm->set_function(\"uint64 get_pause_time()\", &runtime::get_gc_pause_time);\n\t\t\tvm->set_function(\"uint64 get_max_pause_time()\", &runtime::get_gc_max_pause_time);\n\t\t\tvm->set_function(\"uint64 get_scanned_objects()\", &runtime::get_gc_scanned_objects);\n\t\t\tvm->set_function(\"uint64 get_freed_objects()\", &runtime::get_gc_freed_objects);\n\t\t\tvm->set_function(\"uint64 get_detected_cycles()\", &runtime::get_gc_detected_cycles);\n\t\t\tvm->set_function(\"uint64 get_live_objects()\", &runtime::get_gc_live_objects);\n\t\t\tvm->set_function(\"uint64 get_new_objects()\", &runtime::get_gc_new_objects);\n\t\t\tvm->end_namespace();\n\t\t\treturn true;\n\t\t}\n\t\tstatic bool try_context_exit(environment_config& env, int value)\n\t\t{\n\t\t\tif (!env.at_exit.is_valid())\n\t\t\t\treturn false;\n\n\t\t\tauto status = env.at_exit([value](immediate_context* context)\n\t\t\t{\n\t\t\t\tcontext->set_arg32(0, value);\n\t\t\t}).get();\n\t\t\tenv.at_exit.release();\n\t\t\tvirtual_machine::cleanup_this_thread();\n\t\t\treturn !!status;\n\t\t}\n\t\tstatic void apply_context_exit(asIScriptFunction* callback)\n\t\t{\n\t\t\tauto& env = environment_config::get();\n\t\t\tuptr<immediate_context> context = callback ? env.this_compiler->get_vm()->request_context() : nullptr;\n\t\t\tenv.at_exit = function_delegate(callback, *context);\n\t\t}\n\t\tstatic void await_context(std::mutex& mutex, event_loop* loop, virtual_machine* vm, immediate_context* context)\n\t\t{\n\t\t\tauto& env = environment_config::get();\n\t\t\tauto& gc = env.gc;\n\t\t\tauto time = std::chrono::steady_clock::now();\n\t\t\tuint64_t timeout = 1000;\n\t\t\tif (!env.profile.empty())\n\t\t\t\tsampling_profiler::start(env.profile, env.profile_frequency, vm);\n\n\t\t\tauto& completions = native_completions::get();\n\t\t\tcompletions.listen(loop);\n\t\t\tevent_loop::set(loop);\n#ifdef VI_UNIX\n\t\t\tset_worker_ready();\n#endif\n\t\t\twhile (loop->poll_extended(context, timeout) || completions.wait(timeout))\n\t\t\t{\n\t\t\t\tbool idle = std::chrono::steady_clock::now() - time >= std::chrono::milliseconds(timeout);\n\t\t\t\tcompletions.dispatch();\n\t\t\t\tloop->dequeue(vm);\n\t\t\t\ttimeout = collect_garbage(gc, env.gc_stats, vm, idle) ? 1 : 1000;\n\t\t\t\ttime = std::chrono::steady_clock::now();\n\t\t\t\tsampling_profiler::update();\n\t\t\t}\n\n\t\t\tcompletions.reject();\n\t\t\tumutex<std::mutex> unique(mutex);\n\t\t\tif (schedule::has_instance())\n\t\t\t{\n\t\t\t\tauto* queue = schedule::get();\n\t\t\t\twhile (!queue->can_enqueue() && queue->has_any_tasks())\n\t\t\t\t\tqueue->dispatch();\n\t\t\t\tschedule::cleanup_instance();\n\t\t\t}\n\n\t\t\tsampling_profiler::stop();\n\t\t\tcompletions.listen(nullptr);\n\t\t\tevent_loop::set(nullptr);\n\t\t\tcontext->reset();\n\t\t\tenv.gc_stats.begin(vm->get_engine());\n\t\t\tvm->perform_full_garbage_collection();\n\t\t\tenv.gc_stats.end(vm->get_engine(), true);\n\t\t\tif (env.gc_stats.report)\n\t\t\t\tenv.gc_stats.print(vm->get_engine());\n\t\t\tapply_context_exit(nullptr);\n\t\t}\n\t\tstatic void context_thrown(immediate_context* context)\n\t\t{\n\t\t\tif (context->will_exception_be_caught())\n\t\t\t\treturn;\n\n\t\t\tauto exception = bindings::exception::pointer();\n\t\t\texception.load_exception_data(context->get_exception_string());\n\t\t\texception.context = context;\n\n\t\t\tauto& type = exception.get_type();\n\t\t\tauto& text = exception.get_text();\n\t\t\tVI_PANIC(false, \"%s - %s\", type.empty() ? \"unknown_error\" : type.c_str(), text.empty() ? \"no description available\" : text.c_str());\n\t\t}\n\t\tstatic function get_entrypoint(environment_config& env, program_entrypoint& entrypoint, compiler* unit, bool silent = false)\n\t\t{\n\t\t\tfunction main_returns_with_args = unit->get_module().get_function_by_decl(entrypoint.returns_with_args);\n\t\t\tfunction main_returns = unit->get_module().get_function_by_decl(entrypoint.returns);\n\t\t\tfunction main_simple = unit->get_module().get_function_by_decl(entrypoint.simple);\n\t\t\tif (main_returns_with_args.is_valid() || main_returns.is_valid() ||";
+		dc_executable_runtime_hpp += " main_simple.is_valid())\n\t\t\t\treturn main_returns_with_args.is_valid() ? main_returns_with_args : (main_returns.is_valid() ? main_returns : main_simple);\n\n\t\t\tif (!silent)\n\t\t\t\tVI_ERR(\"%s module error: function \\\"%s\\\", \\\"%s\\\" or \\\"%s\\\" must be present\", env.library, entrypoint.returns_with_args, entrypoint.returns, entrypoint.simple);\n\t\t\treturn function(nullptr);\n\t\t}\n\t\tstatic compiler* get_compiler()\n\t\t{\n\t\t\treturn environment_config::get().this_compiler;\n\t\t}\n\t\tstatic bool get_worker()\n\t\t{\n\t\t\treturn is_worker();\n\t\t}\n\t\tstatic uint64_t get_gc_collections()\n\t\t{\n\t\t\treturn environment_config::get().gc_stats.collections;\n\t\t}\n\t\tstatic uint64_t get_gc_pause_time()\n\t\t{\n\t\t\treturn environment_config::get().gc_stats.nanoseconds;\n\t\t}\n\t\tstatic uint64_t get_gc_max_pause_time()\n\t\t{\n\t\t\treturn environment_config::get().gc_stats.max_nanoseconds;\n\t\t}\n\t\tstatic uint64_t get_gc_scanned_objects()\n\t\t{\n\t\t\treturn environment_config::get().gc_stats.scanned;\n\t\t}\n\t\tstatic uint64_t get_gc_freed_objects()\n\t\t{\n\t\t\treturn environment_config::get().gc_stats.freed;\n\t\t}\n\t\tstatic uint64_t get_gc_detected_cycles()\n\t\t{\n\t\t\treturn environment_config::get().gc_stats.detected;\n\t\t}\n\t\tstatic uint64_t get_gc_live_objects()\n\t\t{\n\t\t\tasUINT size = 0;\n\t\t\tenvironment_config::get().this_compiler->get_vm()->get_engine()->GetGCStatistics(&size);\n\t\t\treturn (uint64_t)size;\n\t\t}\n\t\tstatic uint64_t get_gc_new_objects()\n\t\t{\n\t\t\tasUINT new_objects = 0;\n\t\t\tenvironment_config::get().this_compiler->get_vm()->get_engine()->GetGCStatistics(nullptr, nullptr, nullptr, &new_objects);\n\t\t\treturn (uint64_t)new_objects;\n\t\t}\n\t\tstatic bool spawn_workers(size_t count, int& exit_code)\n\t\t{\n#ifdef VI_UNIX\n\t\t\tif (count < 2)\n\t\t\t\treturn false;\n\n\t\t\tif (count > max_workers)\n\t\t\t{\n\t\t\t\tVI_WARN(\"cluster warning: workers count is limited to %i\", (int)max_workers);\n\t\t\t\tcount = max_workers;\n\t\t\t}\n\n\t\t\tauto* workers = get_workers();\n\t\t\tauto* ready = get_ready(true);\n\t\t\tvector<std::chrono::steady_clock::time_point> starts(count);\n\t\t\tfor (size_t i = 0; i < max_workers; i++)\n\t\t\t\tworkers[i] = 0;\n\t\t\tget_workers_count() = (sig_atomic_t)count;\n\t\t\tsignal(SIGCHLD, SIG_DFL);\n\t\t\tsignal(SIGINT, &forward_signal);\n\t\t\tsignal(SIGTERM, &forward_signal);\n\n\t\t\tsize_t alive = 0;\n\t\t\tfor (size_t i = 0; i < count; i++)\n\t\t\t{\n\t\t\t\tpid_t pid = fork();\n\t\t\t\tif (pid == 0)\n\t\t\t\t\treturn enter_worker(i);\n\t\t\t\telse if (pid < 0)\n\t\t\t\t{\n\t\t\t\t\tVI_ERR(\"cluster error: cannot fork worker %i\", (int)i);\n\t\t\t\t\tcontinue;\n\t\t\t\t}\n\n\t\t\t\tVI_DEBUG(\"cluster worker %i started [pid %i]\", (int)i, (int)pid);\n\t\t\t\tstarts[i] = std::chrono::steady_clock::now();\n\t\t\t\tworkers[i] = pid;\n\t\t\t\t++alive;\n\t\t\t}\n\n\t\t\texit_code = 0;\n\t\t\twhile (alive > 0)\n\t\t\t{\n\t\t\t\tint status = 0;\n\t\t\t\tpid_t pid = waitpid(-1, &status, 0);\n\t\t\t\tif (pid < 0)\n\t\t\t\t{\n\t\t\t\t\tif (errno == EINTR)\n\t\t\t\t\t\tcontinue;\n\t\t\t\t\tbreak;\n\t\t\t\t}\n\n\t\t\t\tauto* it = std::find(workers, workers + count, pid);\n\t\t\t\tif (it == workers + count)\n\t\t\t\t\tcontinue;\n\n\t\t\t\tsize_t index = it - workers;\n\t\t\t\tbool crashed = WIFSIGNALED(status) || (WIFEXITED(status) && WEXITSTATUS(status) != 0);\n\t\t\t\tbool started = !ready || ready[index] != 0;\n\t\t\t\t*it = 0;\n\t\t\t\t--alive;\n\t\t\t\tif (!crashed || get_signal() != 0)\n\t\t\t\t{\n\t\t\t\t\tif (crashed && !exit_code)\n\t\t\t\t\t\texit_code = WIFEXITED(status) ? WEXITSTATUS(status) : (int)exit_status::kill;\n\t\t\t\t\tcontinue;\n\t\t\t\t}\n\n\t\t\t\t/* worker that never reached its event loop would fail the same way again (e.g. listener could not be bound) */\n\t\t\t\tif (!started)\n\t\t\t\t{\n\t\t\t\t\tVI_ERR(\"cluster worker %i failed during startup [pid %i]: not restarting\", (int)index, (int)pid);\n\t\t\t\t\tif (!exit_code)\n\t\t\t\t\t\texit_code = WIFEXITED(status) ? WEXITSTATUS(status) : (int)exit_status::kill;\n\t\t\t\t\tcontinue;\n\t\t\t\t}\n\n\t\t\t\tVI_WARN(\"cluster worker %i crashed [pid %i]: restarting\", (int)index, (int)pid);\n\t\t\t\tif (std::chrono::steady_clock::now() - starts[index] < std::chrono::seconds(1))\n\t\t\t\t\tstd::this_thread::sleep_for(std::chrono::seconds(1));\n\n\t\t\t\t/* shutdown signal may arrive during the pause, it is blocked until new pid is visible to forward_signal */\n\t\t\t\tsigset_t mask, previous;\n\t\t\t\tsigemptyset(&mask);\n\t\t\t\tsigaddset(&mask, SIGINT);\n\t\t\t\tsigaddset(&mask, SIGTERM);\n\t\t\t\tsigprocmask(";
+		dc_executable_runtime_hpp += "SIG_BLOCK, &mask, &previous);\n\t\t\t\tif (get_signal() != 0)\n\t\t\t\t{\n\t\t\t\t\tsigprocmask(SIG_SETMASK, &previous, nullptr);\n\t\t\t\t\tcontinue;\n\t\t\t\t}\n\n\t\t\t\tif (ready != nullptr)\n\t\t\t\t\tready[index] = 0;\n\t\t\t\tpid = fork();\n\t\t\t\tif (pid == 0)\n\t\t\t\t{\n\t\t\t\t\tbool result = enter_worker(index);\n\t\t\t\t\tsigprocmask(SIG_SETMASK, &previous, nullptr);\n\t\t\t\t\treturn result;\n\t\t\t\t}\n\t\t\t\telse if (pid > 0)\n\t\t\t\t{\n\t\t\t\t\tstarts[index] = std::chrono::steady_clock::now();\n\t\t\t\t\t*it = pid;\n\t\t\t\t\t++alive;\n\t\t\t\t}\n\t\t\t\telse\n\t\t\t\t\tVI_ERR(\"cluster error: cannot fork worker %i\", (int)index);\n\t\t\t\tsigprocmask(SIG_SETMASK, &previous, nullptr);\n\t\t\t}\n\t\t\treturn true;\n#else\n\t\t\tif (count > 1)\n\t\t\t\tVI_WARN(\"cluster mode is not supported on this platform: running single instance\");\n\t\t\treturn false;\n#endif\n\t\t}\n\t\tstatic bool& is_worker()\n\t\t{\n\t\t\tstatic bool worker = false;\n\t\t\treturn worker;\n\t\t}\n\t\tstatic bool share_socket(size_t fd)\n\t\t{\n#if defined(VI_UNIX) && defined(SO_REUSEPORT)\n\t\t\tif (!is_worker())\n\t\t\t\treturn true;\n\n\t\t\tint value = 1;\n\t\t\treturn setsockopt((int)fd, SOL_SOCKET, SO_REUSEPORT, &value, sizeof(value)) == 0;\n#else\n\t\t\treturn !is_worker();\n#endif\n\t\t}\n\n\tprivate:\n\t\tstatic bool collect_garbage(gc_policy& policy, gc_statistics& stats, virtual_machine* vm, bool idle)\n\t\t{\n\t\t\tasUINT size = 0;\n\t\t\tauto* engine = vm->get_engine();\n\t\t\tif (!policy.adaptive)\n\t\t\t{\n\t\t\t\tauto time = std::chrono::steady_clock::now();\n\t\t\t\tif (time - policy.collected < std::chrono::milliseconds(policy.interval))\n\t\t\t\t\treturn false;\n\n\t\t\t\tstats.begin(engine);\n\t\t\t\tvm->perform_full_garbage_collection();\n\t\t\t\tstats.end(engine, true);\n\t\t\t\tpolicy.collected = time;\n\t\t\t\treturn false;\n\t\t\t}\n\n\t\t\tengine->GetGCStatistics(&size);\n\t\t\tif (size < policy.baseline)\n\t\t\t\tpolicy.baseline = size;\n\n\t\t\tauto time = std::chrono::steady_clock::now();\n\t\t\tbool growing = size >= policy.baseline + policy.growth;\n\t\t\tbool expired = size > policy.baseline && time - policy.collected >= std::chrono::milliseconds(policy.interval);\n\t\t\tbool available = idle && (policy.pending || size > policy.baseline);\n\t\t\tif (!growing && !expired && !available)\n\t\t\t\treturn false;\n\n\t\t\tauto deadline = time + std::chrono::microseconds(policy.pause);\n\t\t\tstats.begin(engine);\n\t\t\tdo\n\t\t\t{\n\t\t\t\tif (engine->GarbageCollect(asGC_ONE_STEP | asGC_DETECT_GARBAGE | asGC_DESTROY_GARBAGE, 1) == 0)\n\t\t\t\t{\n\t\t\t\t\tstats.end(engine, true);\n\t\t\t\t\tengine->GetGCStatistics(&size);\n\t\t\t\t\tpolicy.collected = std::chrono::steady_clock::now();\n\t\t\t\t\tpolicy.baseline = size;\n\t\t\t\t\tpolicy.pending = false;\n\t\t\t\t\treturn false;\n\t\t\t\t}\n\t\t\t} while (std::chrono::steady_clock::now() < deadline);\n\t\t\tstats.end(engine, false);\n\t\t\tpolicy.pending = true;\n\t\t\treturn true;\n\t\t}\n#ifdef VI_UNIX\n\t\tstatic bool enter_worker(size_t index)\n\t\t{\n\t\t\tsignal(SIGINT, SIG_DFL);\n\t\t\tsignal(SIGTERM, SIG_DFL);\n\t\t\tsetenv(\"ASX_WORKER\", std::to_string(index).c_str(), 1);\n\t\t\tget_workers_count() = 0;\n\t\t\tget_worker_index() = index;\n\t\t\tis_worker() = true;\n\t\t\treturn false;\n\t\t}\n\t\tstatic void set_worker_ready()\n\t\t{\n\t\t\tauto* ready = is_worker() ? get_ready(false) : nullptr;\n\t\t\tif (ready != nullptr)\n\t\t\t\tready[get_worker_index()] = 1;\n\t\t}\n\t\tstatic void forward_signal(int value)\n\t\t{\n\t\t\tauto* workers = get_workers();\n\t\t\tsig_atomic_t count = get_workers_count();\n\t\t\tget_signal() = value;\n\t\t\tfor (sig_atomic_t i = 0; i < count; i++)\n\t\t\t{\n\t\t\t\tpid_t pid = workers[i];\n\t\t\t\tif (pid > 0)\n\t\t\t\t\tkill(pid, value);\n\t\t\t}\n\t\t}\n\t\tstatic volatile pid_t* get_workers()\n\t\t{\n\t\t\tstatic volatile pid_t workers[max_workers];\n\t\t\treturn workers;\n\t\t}\n\t\tstatic volatile sig_atomic_t& get_workers_count()\n\t\t{\n\t\t\tstatic volatile sig_atomic_t count = 0;\n\t\t\treturn count;\n\t\t}\n\t\tstatic volatile sig_atomic_t& get_signal()\n\t\t{\n\t\t\tstatic volatile sig_atomic_t value = 0;\n\t\t\treturn value;\n\t\t}\n\t\tstatic volatile sig_atomic_t* get_ready(bool create)\n\t\t{\n\t\t\t/* shared with forked workers, each one marks its own slot once it reaches the event loop */\n\t\t\tstatic volatile sig_atomic_t* ready = nullptr;\n\t\t\tif (!ready && create)\n\t\t\t{\n\t\t\t\tvoid* data = mmap(nullptr, sizeof(sig_atomic_t) * max_workers, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);\n\t\t\t\tready = data != MAP_FAILED ? (volatile sig_atomic_t*)data : nullp";
+		dc_executable_runtime_hpp += "tr;\n\t\t\t}\n\t\t\treturn ready;\n\t\t}\n\t\tstatic size_t& get_worker_index()\n\t\t{\n\t\t\tstatic size_t index = 0;\n\t\t\treturn index;\n\t\t}\n#endif\n\t\tstatic void process_tags(virtual_machine* vm, bindings::tags::tag_info&& info)\n\t\t{\n\t\t\tauto& env = environment_config::get();\n\t\t\tfor (auto& tag : info)\n\t\t\t{\n\t\t\t\tfor (auto& directive : tag.directives)\n\t\t\t\t{\n\t\t\t\t\tif (directive.name != \"#bench\")\n\t\t\t\t\t\tcontinue;\n\n\t\t\t\t\tbenchmark_target target;\n\t\t\t\t\ttarget.name = tag.name;\n\n\t\t\t\t\tauto iterations = directive.args.find(\"iterations\");\n\t\t\t\t\tif (iterations != directive.args.end())\n\t\t\t\t\t\ttarget.iterations = from_string<uint64_t>(iterations->second).or_else(target.iterations);\n\n\t\t\t\t\tauto warmup = directive.args.find(\"warmup\");\n\t\t\t\t\tif (warmup != directive.args.end())\n\t\t\t\t\t\ttarget.warmup = from_string<uint64_t>(warmup->second).or_else(target.warmup);\n\n\t\t\t\t\tenv.benchmarks.push_back(std::move(target));\n\t\t\t\t}\n\n\t\t\t\tif (tag.name != \"main\")\n\t\t\t\t\tcontinue;\n\n\t\t\t\tfor (auto& directive : tag.directives)\n\t\t\t\t{\n\t\t\t\t\tif (directive.name == \"#schedule::main\")\n\t\t\t\t\t{\n\t\t\t\t\t\tauto threads = directive.args.find(\"threads\");\n\t\t\t\t\t\tif (threads != directive.args.end())\n\t\t\t\t\t\t\tenv.auto_schedule = from_string<uint8_t>(threads->second).or_else(0);\n\t\t\t\t\t\telse\n\t\t\t\t\t\t\tenv.auto_schedule = 0;\n\n\t\t\t\t\t\tauto stop = directive.args.find(\"stop\");\n\t\t\t\t\t\tif (stop != directive.args.end())\n\t\t\t\t\t\t{\n\t\t\t\t\t\t\tstringify::to_lower(threads->second);\n\t\t\t\t\t\t\tauto value = from_string<uint8_t>(threads->second);\n\t\t\t\t\t\t\tif (!value)\n\t\t\t\t\t\t\t\tenv.auto_stop = (threads->second == \"on\" || threads->second == \"true\" || threads->second == \"yes\");\n\t\t\t\t\t\t\telse\n\t\t\t\t\t\t\t\tenv.auto_stop = *value > 0;\n\t\t\t\t\t\t}\n\t\t\t\t\t}\n\t\t\t\t\telse if (directive.name == \"#console::main\")\n\t\t\t\t\t\tenv.auto_console = true;\n\t\t\t\t\telse if (directive.name == \"#gc::main\")\n\t\t\t\t\t{\n\t\t\t\t\t\tfor (auto& arg : directive.args)\n\t\t\t\t\t\t{\n\t\t\t\t\t\t\tif (!env.gc.configure(arg.first, arg.second))\n\t\t\t\t\t\t\t\tVI_WARN(\"#gc::main tag warning: invalid argument %s = %s\", arg.first.c_str(), arg.second.c_str());\n\t\t\t\t\t\t}\n\t\t\t\t\t}\n\t\t\t\t}\n\t\t\t}\n\t\t}\n\t};\n}\n#endif\n";
 		callback(context, "executable/runtime.hpp", dc_executable_runtime_hpp.c_str(), (unsigned int)dc_executable_runtime_hpp.size());
 
 		const char* sc_executable_vcpkg_json = "{\n    \"name\": \"{{BUILDER_OUTPUT}}\",\n    \"description\": \"Program: {{BUILDER_OUTPUT}}\",\n    \"version\": \"1.0.0\",\n    \"builtin-baseline\": \"e038ef04796ee67814f36af7c235ae50bbdf4303\",\n    \"dependencies\": {{BUILDER_CONFIG_INSTALL}}\n}";
 		callback(context, "executable/vcpkg.json", sc_executable_vcpkg_json, 226);
+
+		const char* sc_library_cmakelists_txt = "cmake_minimum_required(VERSION 3.10)\nset(VI_DIRECTORY \"{{BUILDER_VENGEANCE_PATH}}\" CACHE STRING \"-\")\nset(VI_LTO OFF CACHE BOOL \"-\")\n{{BUILDER_FEATURES}}\ninclude(${VI_DIRECTORY}/deps/vitex/deps/toolchain.cmake)\nproject(vitex_library)\nset(CMAKE_DISABLE_IN_SOURCE_BUILD ON)\nif (VI_LTO)\n    include(CheckIPOSupported)\n    check_ipo_supported(RESULT LIBRARY_IPO OUTPUT LIBRARY_IPO_ERROR)\n    if (LIBRARY_IPO)\n        set(CMAKE_INTERPROCEDURAL_OPTIMIZATION ON)\n    else()\n        message(WARNING \"LTO is not supported: ${LIBRARY_IPO_ERROR}\")\n    endif()\nendif()\nadd_subdirectory(${VI_DIRECTORY} vitex)\nget_target_property(LIBRARY_QUEUE vitex LINK_LIBRARIES)\nset(LIBRARY_VISITED vitex)\nset(LIBRARY_LINKS \"\")\nwhile (LIBRARY_QUEUE)\n    list(GET LIBRARY_QUEUE 0 LIBRARY_ITEM)\n    list(REMOVE_AT LIBRARY_QUEUE 0)\n    string(REGEX REPLACE \"^\\\\$<LINK_ONLY:(.+)>$\" \"\\\\1\" LIBRARY_ITEM \"${LIBRARY_ITEM}\")\n    if (LIBRARY_ITEM STREQUAL \"\" OR LIBRARY_ITEM IN_LIST LIBRARY_VISITED)\n        continue()\n    endif()\n    list(APPEND LIBRARY_VISITED \"${LIBRARY_ITEM}\")\n    if (TARGET \"${LIBRARY_ITEM}\")\n        get_target_property(LIBRARY_TYPE \"${LIBRARY_ITEM}\" TYPE)\n        if (LIBRARY_TYPE MATCHES \"^(STATIC|SHARED|MODULE|UNKNOWN)_LIBRARY$\")\n            list(APPEND LIBRARY_LINKS \"$<TARGET_LINKER_FILE:${LIBRARY_ITEM}>\")\n        endif()\n        get_target_property(LIBRARY_CHILDS \"${LIBRARY_ITEM}\" INTERFACE_LINK_LIBRARIES)\n        if (LIBRARY_CHILDS)\n            list(APPEND LIBRARY_QUEUE ${LIBRARY_CHILDS})\n        endif()\n    else()\n        list(APPEND LIBRARY_LINKS \"${LIBRARY_ITEM}\")\n    endif()\nendwhile()\nfile(GENERATE OUTPUT \"${CMAKE_BINARY_DIR}/vitex-$<CONFIG>.cmake\" CONTENT \"add_library(vitex UNKNOWN IMPORTED)\nset_target_properties(vitex PROPERTIES\n    IMPORTED_LOCATION \\\"$<TARGET_LINKER_FILE:vitex>\\\"\n    INTERFACE_INCLUDE_DIRECTORIES \\\"$<TARGET_PROPERTY:vitex,INTERFACE_INCLUDE_DIRECTORIES>\\\"\n    INTERFACE_COMPILE_DEFINITIONS \\\"$<TARGET_PROPERTY:vitex,INTERFACE_COMPILE_DEFINITIONS>\\\"\n    INTERFACE_COMPILE_OPTIONS \\\"$<TARGET_PROPERTY:vitex,INTERFACE_COMPILE_OPTIONS>\\\"\n    INTERFACE_LINK_LIBRARIES \\\"${LIBRARY_LINKS}\\\")\n\")";
+		callback(context, "library/CMakeLists.txt", sc_library_cmakelists_txt, 2118);
 	}
 }
 #endif
\ No newline at end of file
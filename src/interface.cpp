@@ -1,6 +1,407 @@
 #include "interface.h"
 #include "app.h"
 
+struct native_promise
+{
+	asITypeInfo* type;
+	int type_id;
+};
+
+static std::mutex promises_mutex;
+static unordered_map<void*, native_promise> promises;
+
+static_assert(offsetof(asx::shared_buffer, data) == offsetof(asx_buffer, data) && offsetof(asx::shared_buffer, size) == offsetof(asx_buffer, size), "native_buffer layout must start with asx_buffer");
+
+static size_t get_class_behaviours(size_t flags)
+{
+	return (size_t)object_behaviours::value |
+		(size_t)object_behaviours::app_class |
+		(flags & (1 << 0) ? (size_t)object_behaviours::app_class_constructor : 0) |
+		(flags & (1 << 1) ? (size_t)object_behaviours::app_class_destructor : 0) |
+		(flags & (1 << 2) ? (size_t)object_behaviours::app_class_assignment : 0) |
+		(flags & (1 << 4) ? (size_t)object_behaviours::app_class_copy_constructor : 0);
+}
+static void set_class_method(type_class& base, const asx_class_method_info& method)
+{
+	VI_ASSERT(method.address != nullptr, "method function address should be set");
+	switch (method.type)
+	{
+		case asx_member_operator:
+			VI_ASSERT(method.declaration != nullptr, "declaration should be set");
+			base.set_operator_address(method.declaration, bridge::function_call(method.address)).expect("binding error");
+			break;
+		case asx_member_constructor:
+			VI_ASSERT(method.declaration != nullptr, "declaration should be set");
+			base.set_constructor_address(method.declaration, bridge::function_call(reinterpret_cast<void(*)(void*)>(method.address))).expect("binding error");
+			break;
+		case asx_member_copy_operator:
+			base.set_operator_copy_address(bridge::function_call(method.address)).expect("binding error");
+			break;
+		case asx_member_destructor:
+			base.set_destructor_address("void f()", bridge::function_call(reinterpret_cast<void(*)(void*)>(method.address))).expect("binding error");
+			break;
+		case asx_member_method:
+		default:
+			VI_ASSERT(method.declaration != nullptr, "declaration should be set");
+			base.set_method_address(method.declaration, bridge::function_call(method.address)).expect("binding error");
+			break;
+	}
+}
+static void resolve_promise(asx_promise* target, std::function<void(bindings::promise*, int)>&& callback)
+{
+	VI_ASSERT(target != nullptr, "promise should be set");
+	native_promise info;
+	{
+		umutex<std::mutex> unique(promises_mutex);
+		auto it = promises.find(target);
+		if (it == promises.end())
+		{
+			VI_ERR("promise error: promise is unknown or already settled");
+			return;
+		}
+
+		info = it->second;
+		promises.erase(it);
+	}
+
+	/* settled on the event loop thread so that awaiting contexts are resumed by it */
+	asx::native_completions::get().push([target, info, callback = std::move(callback)]()
+	{
+		callback((bindings::promise*)target, info.type_id);
+		asx::environment::get()->vm->get_engine()->ReleaseScriptObject(target, info.type);
+	});
+}
+static void abandon_promises()
+{
+	vector<void*> targets;
+	{
+		umutex<std::mutex> unique(promises_mutex);
+		targets.reserve(promises.size());
+		for (auto& item : promises)
+			targets.push_back(item.first);
+	}
+
+	/* native side may still settle them later, that is reported as already settled */
+	for (auto* target : targets)
+		asx_promise_reject((asx_promise*)target, "promise was not settled before shutdown");
+}
+template <typename t>
+static void store_number(bindings::promise* target, int type_id, t value)
+{
+	switch (type_id)
+	{
+		case asTYPEID_BOOL:
+		{
+			bool data = value != 0;
+			target->store(&data, type_id);
+			break;
+		}
+		case asTYPEID_INT8:
+		{
+			int8_t data = (int8_t)value;
+			target->store(&data, type_id);
+			break;
+		}
+		case asTYPEID_INT16:
+		{
+			int16_t data = (int16_t)value;
+			target->store(&data, type_id);
+			break;
+		}
+		case asTYPEID_INT32:
+		{
+			int32_t data = (int32_t)value;
+			target->store(&data, type_id);
+			break;
+		}
+		case asTYPEID_INT64:
+		{
+			int64_t data = (int64_t)value;
+			target->store(&data, type_id);
+			break;
+		}
+		case asTYPEID_UINT8:
+		{
+			uint8_t data = (uint8_t)value;
+			target->store(&data, type_id);
+			break;
+		}
+		case asTYPEID_UINT16:
+		{
+			uint16_t data = (uint16_t)value;
+			target->store(&data, type_id);
+			break;
+		}
+		case asTYPEID_UINT32:
+		{
+			uint32_t data = (uint32_t)value;
+			target->store(&data, type_id);
+			break;
+		}
+		case asTYPEID_UINT64:
+		{
+			uint64_t data = (uint64_t)value;
+			target->store(&data, type_id);
+			break;
+		}
+		case asTYPEID_FLOAT:
+		{
+			float data = (float)value;
+			target->store(&data, type_id);
+			break;
+		}
+		case asTYPEID_DOUBLE:
+		{
+			double data = (double)value;
+			target->store(&data, type_id);
+			break;
+		}
+		default:
+			target->store_exception(bindings::exception::pointer("type_error", "promise value is not a number"));
+			break;
+	}
+}
+
+const asx_interface_table* asx_get_interface(size_t version)
+{
+	static const asx_interface_table table =
+	{
+		ASX_INTERFACE_VERSION,
+		&asx_import_builtin,
+		&asx_import_native,
+		&asx_export_property,
+		&asx_export_function_address,
+		&asx_export_namespace_begin,
+		&asx_export_namespace_end,
+		&asx_export_enum,
+		&asx_export_enum_value,
+		&asx_export_class_address,
+		&asx_export_class_property_address,
+		&asx_export_class_constructor_address,
+		&asx_export_class_operator_address,
+		&asx_export_class_copy_operator_address,
+		&asx_export_class_destructor_address,
+		&asx_export_class_method_address,
+		&asx_export_namespaces,
+		&asx_buffer_create,
+		&asx_buffer_wrap,
+		&asx_buffer_add_ref,
+		&asx_buffer_release,
+		&asx_promise_create,
+		&asx_promise_resolve_void,
+		&asx_promise_resolve_integer,
+		&asx_promise_resolve_number,
+		&asx_promise_resolve_string,
+		&asx_promise_resolve_buffer,
+		&asx_promise_reject,
+		&asx_execute_async
+	};
+	return version > 0 && version <= ASX_INTERFACE_VERSION ? &table : nullptr;
+}
+int asx_export_namespaces(size_t version, const asx_namespace_info* namespaces, size_t namespaces_count)
+{
+	VI_ASSERT(namespaces != nullptr || !namespaces_count, "namespaces should be set");
+	if (!version || version > ASX_INTERFACE_VERSION)
+	{
+		VI_ERR("addon interface version %i is not supported (runtime version is %i)", (int)version, (int)ASX_INTERFACE_VERSION);
+		return -1;
+	}
+
+	/* types are declared first so that any member may refer to any class or enum of the table */
+	auto* vm = asx::environment::get()->vm;
+	vector<type_class> types;
+	for (size_t i = 0; i < namespaces_count; i++)
+	{
+		auto& space = namespaces[i];
+		bool scoped = space.name != nullptr && *space.name != '\0';
+		if (scoped)
+			vm->begin_namespace(space.name).expect("binding error");
+
+		for (size_t j = 0; j < space.enums_count; j++)
+		{
+			auto& target = space.enums[j];
+			VI_ASSERT(target.name != nullptr, "name should be set");
+			vm->set_enum(target.name).expect("binding error");
+
+			auto type = vm->get_type_info_by_name(target.name);
+			auto base = enumeration(vm, type.get_type_info(), type.get_type_id());
+			for (size_t k = 0; k < target.values_count; k++)
+			{
+				VI_ASSERT(target.values[k].declaration != nullptr, "declaration should be set");
+				base.set_value(target.values[k].declaration, target.values[k].value).expect("binding error");
+			}
+		}
+
+		for (size_t j = 0; j < space.classes_count; j++)
+		{
+			auto& target = space.classes[j];
+			VI_ASSERT(target.name != nullptr, "name should be set");
+			vm->set_struct_address(target.name, target.size, get_class_behaviours(target.flags));
+
+			auto type = vm->get_type_info_by_name(target.name);
+			types.push_back(type_class(vm, type.get_type_info(), type.get_type_id()));
+		}
+
+		if (scoped)
+			vm->end_namespace().expect("binding error");
+	}
+
+	size_t index = 0;
+	for (size_t i = 0; i < namespaces_count; i++)
+	{
+		auto& space = namespaces[i];
+		bool scoped = space.name != nullptr && *space.name != '\0';
+		if (scoped)
+			vm->begin_namespace(space.name).expect("binding error");
+
+		for (size_t j = 0; j < space.classes_count; j++)
+		{
+			auto& target = space.classes[j];
+			auto& base = types[index++];
+			for (size_t k = 0; k < target.properties_count; k++)
+			{
+				VI_ASSERT(target.properties[k].declaration != nullptr, "declaration should be set");
+				base.set_property_address(target.properties[k].declaration, target.properties[k].offset).expect("binding error");
+			}
+
+			for (size_t k = 0; k < target.methods_count; k++)
+				set_class_method(base, target.methods[k]);
+		}
+
+		for (size_t j = 0; j < space.functions_count; j++)
+		{
+			auto& target = space.functions[j];
+			VI_ASSERT(target.declaration != nullptr, "declaration should be set");
+			VI_ASSERT(target.address != nullptr, "function address should be set");
+			vm->set_function_address(target.declaration, bridge::function_call(target.address)).expect("binding error");
+		}
+
+		for (size_t j = 0; j < space.properties_count; j++)
+		{
+			auto& target = space.properties[j];
+			VI_ASSERT(target.declaration != nullptr, "declaration should be set");
+			VI_ASSERT(target.address != nullptr, "property address should be set");
+			vm->set_property_address(target.declaration, target.address).expect("binding error");
+		}
+
+		if (scoped)
+			vm->end_namespace().expect("binding error");
+	}
+
+	return 0;
+}
+
+asx_buffer* asx_buffer_create(size_t size)
+{
+	return (asx_buffer*)asx::shared_buffer::create((uint64_t)size);
+}
+asx_buffer* asx_buffer_wrap(void* data, size_t size, void(*release_callback)(void* data, void* context), void* context)
+{
+	VI_ASSERT(data != nullptr || !size, "data should be set");
+	return (asx_buffer*)asx::shared_buffer::wrap(data, size, release_callback, context);
+}
+void asx_buffer_add_ref(asx_buffer* buffer)
+{
+	VI_ASSERT(buffer != nullptr, "buffer should be set");
+	((asx::shared_buffer*)buffer)->add_ref();
+}
+void asx_buffer_release(asx_buffer* buffer)
+{
+	VI_ASSERT(buffer != nullptr, "buffer should be set");
+	((asx::shared_buffer*)buffer)->release();
+}
+asx_promise* asx_promise_create(const char* type)
+{
+	VI_ASSERT(type != nullptr, "type should be set");
+	auto* vm = asx::environment::get()->vm;
+	bool is_void = !strcmp(type, "void");
+	auto info = vm->get_type_info_by_decl(is_void ? string("promise_v@") : "promise<" + string(type) + ">@");
+	if (!info.is_valid())
+	{
+		VI_ERR("%s promise error: type is not supported", type);
+		return nullptr;
+	}
+
+	auto* engine = vm->get_engine();
+	void* object = engine->CreateScriptObject(info.get_type_info());
+	if (!object)
+	{
+		VI_ERR("%s promise error: cannot be created", type);
+		return nullptr;
+	}
+
+	/* one reference is returned to the script, another one is kept until promise is settled */
+	engine->AddRefScriptObject(object, info.get_type_info());
+	{
+		umutex<std::mutex> unique(promises_mutex);
+		promises[object] = { info.get_type_info(), is_void ? 0 : engine->GetTypeIdByDecl(type) };
+	}
+	asx::native_completions::get().begin(&abandon_promises);
+	return (asx_promise*)object;
+}
+void asx_promise_resolve_void(asx_promise* target)
+{
+	resolve_promise(target, [](bindings::promise* base, int type_id)
+	{
+		if (!type_id)
+			base->store_void();
+		else
+			base->store_exception(bindings::exception::pointer("type_error", "promise expects a value"));
+	});
+}
+void asx_promise_resolve_integer(asx_promise* target, int64_t value)
+{
+	resolve_promise(target, [value](bindings::promise* base, int type_id)
+	{
+		store_number(base, type_id, value);
+	});
+}
+void asx_promise_resolve_number(asx_promise* target, double value)
+{
+	resolve_promise(target, [value](bindings::promise* base, int type_id)
+	{
+		store_number(base, type_id, value);
+	});
+}
+void asx_promise_resolve_string(asx_promise* target, const char* data, size_t size)
+{
+	VI_ASSERT(data != nullptr || !size, "data should be set");
+	resolve_promise(target, [value = string(data, size)](bindings::promise* base, int type_id) mutable
+	{
+		if (type_id == asx::environment::get()->vm->get_engine()->GetTypeIdByDecl("string"))
+			base->store(&value, type_id);
+		else
+			base->store_exception(bindings::exception::pointer("type_error", "promise value is not a string"));
+	});
+}
+void asx_promise_resolve_buffer(asx_promise* target, asx_buffer* value)
+{
+	VI_ASSERT(value != nullptr, "buffer should be set");
+	resolve_promise(target, [value](bindings::promise* base, int type_id)
+	{
+		auto* buffer = (asx::shared_buffer*)value;
+		if (type_id == asx::environment::get()->vm->get_engine()->GetTypeIdByDecl("native_buffer@"))
+			base->store(&buffer, type_id);
+		else
+			base->store_exception(bindings::exception::pointer("type_error", "promise value is not a native_buffer"));
+		buffer->release();
+	});
+}
+void asx_promise_reject(asx_promise* target, const char* message)
+{
+	resolve_promise(target, [value = string(message ? message : "")](bindings::promise* base, int)
+	{
+		base->store_exception(bindings::exception::pointer("native_error", value));
+	});
+}
+bool asx_execute_async(void(*callback)(void* context), void* context)
+{
+	VI_ASSERT(callback != nullptr, "callback should be set");
+	if (!schedule::is_available())
+		return false;
+
+	return schedule::get()->set_task([callback, context]() { callback(context); }) != INVALID_TASK_ID;
+}
 void asx_import_builtin(const char* path)
 {
 	VI_ASSERT(path != nullptr, "path should be set");
@@ -57,13 +458,7 @@ void asx_export_class_address(const char* name, size_t size, size_t flags)
 {
 	VI_ASSERT(name != nullptr, "name should be set");
 	auto* env = asx::environment::get();
-	auto base = env->vm->set_struct_address(name, size,
-		(size_t)object_behaviours::value |
-		(size_t)object_behaviours::app_class |
-		(flags & (1 << 0) ? (size_t)object_behaviours::app_class_constructor : 0) |
-		(flags & (1 << 0) ? (size_t)object_behaviours::app_class_destructor : 0) |
-		(flags & (1 << 0) ? (size_t)object_behaviours::app_class_assignment : 0) |
-		(flags & (1 << 0) ? (size_t)object_behaviours::app_class_copy_constructor : 0));
+	auto base = env->vm->set_struct_address(name, size, get_class_behaviours(flags));
 }
 void asx_export_class_property_address(const char* name, const char* declaration, int property_offset)
 {
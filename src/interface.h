@@ -6,8 +6,136 @@
 #else
 #define VI_EXPORT
 #endif
+#ifndef ASX_INTERFACE_VERSION
+#define ASX_INTERFACE_VERSION 4
+enum asx_member_type
+{
+	asx_member_method = 0,
+	asx_member_operator = 1,
+	asx_member_constructor = 2,
+	asx_member_copy_operator = 3,
+	asx_member_destructor = 4
+};
+
+struct asx_enum_value_info
+{
+	const char* declaration;
+	int value;
+};
+
+struct asx_enum_info
+{
+	const char* name;
+	const asx_enum_value_info* values;
+	size_t values_count;
+};
+
+struct asx_property_info
+{
+	const char* declaration;
+	void* address;
+};
+
+struct asx_function_info
+{
+	const char* declaration;
+	void(*address)();
+};
+
+struct asx_class_property_info
+{
+	const char* declaration;
+	int offset;
+};
+
+struct asx_class_method_info
+{
+	asx_member_type type;
+	const char* declaration;
+	void(*address)();
+};
+
+struct asx_class_info
+{
+	const char* name;
+	size_t size;
+	size_t flags;
+	const asx_class_property_info* properties;
+	size_t properties_count;
+	const asx_class_method_info* methods;
+	size_t methods_count;
+};
+
+struct asx_namespace_info
+{
+	const char* name;
+	const asx_enum_info* enums;
+	size_t enums_count;
+	const asx_class_info* classes;
+	size_t classes_count;
+	const asx_function_info* functions;
+	size_t functions_count;
+	const asx_property_info* properties;
+	size_t properties_count;
+};
+
+struct asx_buffer
+{
+	unsigned char* data;
+	size_t size;
+};
+
+struct asx_promise;
+
+struct asx_interface_table
+{
+	size_t version;
+	void(*import_builtin)(const char* path);
+	void(*import_native)(const char* path);
+	void(*export_property)(const char* declaration, void* property_address);
+	void(*export_function_address)(const char* declaration, void(*function_address)());
+	void(*export_namespace_begin)(const char* name);
+	void(*export_namespace_end)();
+	void(*export_enum)(const char* name);
+	void(*export_enum_value)(const char* name, const char* declaration, int value);
+	void(*export_class_address)(const char* name, size_t size, size_t flags);
+	void(*export_class_property_address)(const char* name, const char* declaration, int property_offset);
+	void(*export_class_constructor_address)(const char* name, const char* declaration, void(*constructor_function_address)(void*));
+	void(*export_class_operator_address)(const char* name, const char* declaration, void(*operator_function_address)());
+	void(*export_class_copy_operator_address)(const char* name, void(*copy_operator_function_address)());
+	void(*export_class_destructor_address)(const char* name, void(*destructor_function_address)(void*));
+	void(*export_class_method_address)(const char* name, const char* declaration, void(*method_function_address)());
+	int(*export_namespaces)(size_t version, const asx_namespace_info* namespaces, size_t namespaces_count);
+	asx_buffer*(*buffer_create)(size_t size);
+	asx_buffer*(*buffer_wrap)(void* data, size_t size, void(*release_callback)(void* data, void* context), void* context);
+	void(*buffer_add_ref)(asx_buffer* buffer);
+	void(*buffer_release)(asx_buffer* buffer);
+	asx_promise*(*promise_create)(const char* type);
+	void(*promise_resolve_void)(asx_promise* target);
+	void(*promise_resolve_integer)(asx_promise* target, int64_t value);
+	void(*promise_resolve_number)(asx_promise* target, double value);
+	void(*promise_resolve_string)(asx_promise* target, const char* data, size_t size);
+	void(*promise_resolve_buffer)(asx_promise* target, asx_buffer* value);
+	void(*promise_reject)(asx_promise* target, const char* message);
+	bool(*execute_async)(void(*callback)(void* context), void* context);
+};
+#endif
 extern "C"
 {
+	VI_EXPORT const asx_interface_table* asx_get_interface(size_t version);
+	VI_EXPORT int asx_export_namespaces(size_t version, const asx_namespace_info* namespaces, size_t namespaces_count);
+	VI_EXPORT asx_buffer* asx_buffer_create(size_t size);
+	VI_EXPORT asx_buffer* asx_buffer_wrap(void* data, size_t size, void(*release_callback)(void* data, void* context), void* context);
+	VI_EXPORT void asx_buffer_add_ref(asx_buffer* buffer);
+	VI_EXPORT void asx_buffer_release(asx_buffer* buffer);
+	VI_EXPORT asx_promise* asx_promise_create(const char* type);
+	VI_EXPORT void asx_promise_resolve_void(asx_promise* target);
+	VI_EXPORT void asx_promise_resolve_integer(asx_promise* target, int64_t value);
+	VI_EXPORT void asx_promise_resolve_number(asx_promise* target, double value);
+	VI_EXPORT void asx_promise_resolve_string(asx_promise* target, const char* data, size_t size);
+	VI_EXPORT void asx_promise_resolve_buffer(asx_promise* target, asx_buffer* value);
+	VI_EXPORT void asx_promise_reject(asx_promise* target, const char* message);
+	VI_EXPORT bool asx_execute_async(void(*callback)(void* context), void* context);
 	VI_EXPORT void asx_import_builtin(const char* path);
 	VI_EXPORT void asx_import_native(const char* path);
 	VI_EXPORT void asx_export_property(const char* declaration, void* property_address);
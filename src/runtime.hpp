@@ -2,6 +2,24 @@
 #define RUNTIME_H
 #include <vengeance/bindings.h>
 #include <vengeance/vengeance.h>
+#include <chrono>
+#include <atomic>
+#include <condition_variable>
+#include <thread>
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define ASX_HEAP_USAGE
+#endif
+#ifdef VI_UNIX
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <dlfcn.h>
+#include <unistd.h>
+#endif
 
 using namespace vitex::core;
 using namespace vitex::compute;
@@ -33,11 +51,501 @@ namespace asx
 		const char* simple = "void main()";
 	};
 
+	struct startup_profiler
+	{
+		struct phase
+		{
+			string name;
+			int64_t nanoseconds;
+			int64_t retained_bytes;
+			int64_t peak_rss_kb;
+		};
+
+		vector<phase> phases;
+		std::chrono::steady_clock::time_point origin;
+		std::chrono::steady_clock::time_point time;
+		string output;
+		int64_t retained = 0;
+		bool active = false;
+
+		void start(const char* target)
+		{
+			if (!target)
+				return;
+
+			active = true;
+			output = strcmp(target, "1") != 0 ? target : "";
+			origin = time = std::chrono::steady_clock::now();
+			retained = get_retained_bytes();
+		}
+		void record(const std::string_view& name)
+		{
+			if (!active)
+				return;
+
+			auto next_time = std::chrono::steady_clock::now();
+			int64_t next_retained = get_retained_bytes();
+			phases.push_back({ string(name), (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(next_time - time).count(), next_retained - retained, get_peak_rss_kb() });
+			time = next_time;
+			retained = next_retained;
+		}
+		void finish()
+		{
+			if (!active)
+				return;
+
+			uptr<schema> data = var::set::object();
+			schema* items = data->set("phases", var::set::array());
+			for (auto& item : phases)
+			{
+				schema* next = items->push(var::set::object());
+				next->set("name", var::string(item.name));
+				next->set("nanoseconds", var::integer(item.nanoseconds));
+				next->set("retained_bytes", var::integer(item.retained_bytes));
+				next->set("peak_rss_kb", var::integer(item.peak_rss_kb));
+			}
+			data->set("total_nanoseconds", var::integer((int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(time - origin).count()));
+
+			active = false;
+			string result = schema::to_json(*data);
+			if (output.empty())
+				fprintf(stderr, "%s\n", result.c_str());
+			else if (!os::file::write(output, (uint8_t*)result.data(), result.size()))
+				VI_ERR("%s profile error: write failed", output.c_str());
+		}
+		static int64_t get_peak_rss_kb()
+		{
+#ifdef VI_UNIX
+			struct rusage usage;
+			memset(&usage, 0, sizeof(usage));
+			if (getrusage(RUSAGE_SELF, &usage) != 0)
+				return 0;
+#ifdef __APPLE__
+			return (int64_t)usage.ru_maxrss / 1024;
+#else
+			return (int64_t)usage.ru_maxrss;
+#endif
+#else
+			return 0;
+#endif
+		}
+		static int64_t get_retained_bytes()
+		{
+			/* bytes held by malloc heap right now, a difference of two calls is net growth and not a count of allocations */
+#ifdef ASX_HEAP_USAGE
+			return (int64_t)mallinfo2().uordblks;
+#else
+			return 0;
+#endif
+		}
+	};
+
+	struct gc_policy
+	{
+		std::chrono::steady_clock::time_point collected = std::chrono::steady_clock::now();
+		uint64_t pause = 2000;
+		uint64_t growth = 1024;
+		uint64_t interval = 60000;
+		uint32_t baseline = 0;
+		bool adaptive = true;
+		bool pending = false;
+
+		bool configure(const std::string_view& name, const std::string_view& value)
+		{
+			auto numeric = from_string<uint64_t>(value);
+			if (name == "adaptive")
+			{
+				if (numeric)
+					adaptive = *numeric > 0;
+				else if (value == "on" || value == "true" || value == "yes")
+					adaptive = true;
+				else if (value == "off" || value == "false" || value == "no")
+					adaptive = false;
+				else
+					return false;
+
+				return true;
+			}
+			else if (!numeric)
+				return false;
+
+			if (name == "pause")
+				pause = *numeric;
+			else if (name == "growth")
+				growth = *numeric;
+			else if (name == "interval")
+				interval = *numeric;
+			else
+				return false;
+
+			return true;
+		}
+	};
+
+	struct gc_statistics
+	{
+		std::chrono::steady_clock::time_point time;
+		uint64_t collections = 0;
+		uint64_t nanoseconds = 0;
+		uint64_t max_nanoseconds = 0;
+		uint64_t scanned = 0;
+		uint64_t freed = 0;
+		uint64_t detected = 0;
+		asUINT destroyed_before = 0;
+		asUINT detected_before = 0;
+		bool cycle = false;
+		bool report = false;
+
+		void begin(asIScriptEngine* engine)
+		{
+			asUINT size = 0, destroyed = 0, new_destroyed = 0;
+			engine->GetGCStatistics(&size, &destroyed, &detected_before, nullptr, &new_destroyed);
+			destroyed_before = destroyed + new_destroyed;
+			if (!cycle)
+			{
+				/* incremental steps of one cycle walk the same set of objects */
+				scanned += size;
+				cycle = true;
+			}
+			time = std::chrono::steady_clock::now();
+		}
+		void end(asIScriptEngine* engine, bool completed)
+		{
+			uint64_t delta = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time).count();
+			asUINT destroyed = 0, new_destroyed = 0, detected_after = 0;
+			engine->GetGCStatistics(nullptr, &destroyed, &detected_after, nullptr, &new_destroyed);
+			freed += (uint64_t)(destroyed + new_destroyed - destroyed_before);
+			detected += (uint64_t)(detected_after - detected_before);
+			max_nanoseconds = std::max(max_nanoseconds, delta);
+			nanoseconds += delta;
+			if (!completed)
+				return;
+
+			cycle = false;
+			++collections;
+		}
+		void print(asIScriptEngine* engine)
+		{
+			asUINT size = 0, new_objects = 0;
+			engine->GetGCStatistics(&size, nullptr, nullptr, &new_objects, nullptr);
+			fprintf(stderr, "gc: %" PRIu64 " collections, %.3fms total, %.3fms max pause, %" PRIu64 " scanned, %" PRIu64 " freed, %" PRIu64 " cycles detected, %u live objects (%u new)\n",
+				collections, (double)nanoseconds / 1000000.0, (double)max_nanoseconds / 1000000.0, scanned, freed, detected, (uint32_t)size, (uint32_t)new_objects);
+		}
+	};
+
+	struct shared_buffer
+	{
+		uint8_t* data = nullptr;
+		size_t size = 0;
+		shared_buffer* parent = nullptr;
+		void(*release_callback)(void* data, void* context) = nullptr;
+		void* release_context = nullptr;
+		std::atomic<int32_t> references = 1;
+
+		void add_ref()
+		{
+			++references;
+		}
+		void release()
+		{
+			if (--references > 0)
+				return;
+
+			if (parent != nullptr)
+				parent->release();
+			else if (release_callback != nullptr)
+				release_callback(data, release_context);
+			else
+				delete[] data;
+			delete this;
+		}
+		void fill(uint8_t value)
+		{
+			if (size > 0)
+				memset(data, value, size);
+		}
+		void copy(uint64_t offset, const shared_buffer& from)
+		{
+			if (offset > size || from.size > size - offset)
+				throw_exception("buffer copy out of range");
+			else if (from.size > 0)
+				memmove(data + offset, from.data, from.size);
+		}
+		uint8_t* at(uint64_t index)
+		{
+			if (index < size)
+				return data + index;
+
+			throw_exception("buffer index out of range");
+			return nullptr;
+		}
+		uint64_t get_size() const
+		{
+			return (uint64_t)size;
+		}
+		shared_buffer* slice(uint64_t offset, uint64_t count)
+		{
+			if (offset > size || count > size - offset)
+			{
+				throw_exception("buffer slice out of range");
+				return nullptr;
+			}
+
+			auto* result = new shared_buffer();
+			result->data = data + offset;
+			result->size = (size_t)count;
+			result->parent = parent ? parent : this;
+			result->parent->add_ref();
+			return result;
+		}
+		static shared_buffer* create(uint64_t size)
+		{
+			auto* result = new shared_buffer();
+			result->data = size > 0 ? new uint8_t[(size_t)size]() : nullptr;
+			result->size = (size_t)size;
+			return result;
+		}
+		static shared_buffer* wrap(void* data, size_t size, void(*release_callback)(void*, void*), void* release_context)
+		{
+			auto* result = new shared_buffer();
+			result->data = (uint8_t*)data;
+			result->size = size;
+			result->release_callback = release_callback;
+			result->release_context = release_context;
+			return result;
+		}
+		static void throw_exception(const char* message)
+		{
+			auto* context = asGetActiveContext();
+			if (context != nullptr)
+				context->SetException(message);
+		}
+		static bool bind(virtual_machine* vm)
+		{
+			auto base = vm->set_class_address("native_buffer", sizeof(shared_buffer), (size_t)object_behaviours::ref);
+			expects_vm<void> results[] =
+			{
+				base.set_behaviour_address("native_buffer@ f(uint64)", behaviours::factory, bridge::function(&shared_buffer::create), function_call::cdecl_call),
+				base.set_behaviour_address("void f()", behaviours::addref, bridge::method(&shared_buffer::add_ref), function_call::thiscall),
+				base.set_behaviour_address("void f()", behaviours::release, bridge::method(&shared_buffer::release), function_call::thiscall),
+				base.set_method("uint8& opIndex(uint64)", &shared_buffer::at),
+				base.set_method("const uint8& opIndex(uint64) const", &shared_buffer::at),
+				base.set_method("uint64 size() const", &shared_buffer::get_size),
+				base.set_method("native_buffer@ slice(uint64, uint64)", &shared_buffer::slice),
+				base.set_method("void fill(uint8)", &shared_buffer::fill),
+				base.set_method("void copy(uint64, const native_buffer&in)", &shared_buffer::copy)
+			};
+
+			for (auto& status : results)
+			{
+				if (!status)
+				{
+					VI_ERR("native_buffer binding error: %s", status.error().what());
+					return false;
+				}
+			}
+			return true;
+		}
+	};
+
+	struct native_completions
+	{
+		vector<std::function<void()>> callbacks;
+		std::condition_variable condition;
+		std::mutex mutex;
+		event_loop* loop = nullptr;
+		void(*abandon)() = nullptr;
+		size_t pending = 0;
+		std::atomic<bool> stopping = false;
+
+		void listen(event_loop* target)
+		{
+			umutex<std::mutex> unique(mutex);
+			loop = target;
+		}
+		void begin(void(*abandon_callback)())
+		{
+			umutex<std::mutex> unique(mutex);
+			abandon = abandon_callback;
+			++pending;
+		}
+		void push(std::function<void()>&& callback)
+		{
+			umutex<std::mutex> unique(mutex);
+			callbacks.push_back(std::move(callback));
+			condition.notify_one();
+			if (loop != nullptr)
+				loop->wakeup();
+		}
+		bool dispatch()
+		{
+			vector<std::function<void()>> queue;
+			{
+				umutex<std::mutex> unique(mutex);
+				queue.swap(callbacks);
+				pending -= std::min(pending, queue.size());
+			}
+
+			for (auto& callback : queue)
+				callback();
+			return !queue.empty();
+		}
+		void stop()
+		{
+			/* called from signal handlers, waiting loop notices it on timeout at the latest */
+			stopping = true;
+		}
+		void reject()
+		{
+			void(*callback)() = nullptr;
+			{
+				umutex<std::mutex> unique(mutex);
+				if (!pending)
+					return;
+
+				callback = abandon;
+			}
+
+			if (callback != nullptr)
+				callback();
+			dispatch();
+		}
+		bool wait(uint64_t timeout)
+		{
+			std::unique_lock<std::mutex> unique(mutex);
+			if (!pending || stopping)
+				return false;
+
+			condition.wait_for(unique, std::chrono::milliseconds(timeout), [this]() { return !callbacks.empty() || stopping; });
+			return true;
+		}
+		static native_completions& get()
+		{
+			static native_completions base;
+			return base;
+		}
+	};
+
+	struct aot_function
+	{
+		const char* declaration;
+		uint64_t hash;
+		asUINT length;
+		asJITFunction callable;
+		const asUINT* entries;
+		asUINT entries_count;
+
+		static uint64_t get_hash(const asDWORD* byte_code, asUINT length)
+		{
+			/* operands of interpreted instructions hold process specific pointers and ids, only translated ones are compared in full */
+			uint64_t hash = 0xcbf29ce484222325;
+			for (asUINT i = 0; i < length;)
+			{
+				asBYTE op = *(const asBYTE*)(byte_code + i);
+				asUINT size = (asUINT)asBCTypeSize[asBCInfo[op].type];
+				if (is_translated(op))
+				{
+					for (asUINT j = 0; j < size && i + j < length; j++)
+						hash = (hash ^ byte_code[i + j]) * 0x100000001b3;
+				}
+				else
+					hash = (hash ^ op) * 0x100000001b3;
+				i += size > 0 ? size : 1;
+			}
+			return hash;
+		}
+		static bool is_translated(asBYTE op)
+		{
+			switch (op)
+			{
+				case asBC_SUSPEND: case asBC_SetV1: case asBC_SetV2: case asBC_SetV4: case asBC_SetV8:
+				case asBC_CpyVtoV4: case asBC_CpyVtoV8: case asBC_CpyVtoR4: case asBC_CpyVtoR8: case asBC_CpyRtoV4: case asBC_CpyRtoV8: case asBC_ClrHi:
+				case asBC_CMPi: case asBC_CMPu: case asBC_CMPf: case asBC_CMPd: case asBC_CMPi64: case asBC_CMPu64: case asBC_CMPIi: case asBC_CMPIu: case asBC_CMPIf:
+				case asBC_TZ: case asBC_TNZ: case asBC_TS: case asBC_TNS: case asBC_TP: case asBC_TNP:
+				case asBC_JMP: case asBC_JZ: case asBC_JNZ: case asBC_JS: case asBC_JNS: case asBC_JP: case asBC_JNP: case asBC_JLowZ: case asBC_JLowNZ:
+				case asBC_ADDi: case asBC_SUBi: case asBC_MULi: case asBC_DIVi: case asBC_MODi: case asBC_DIVu: case asBC_MODu:
+				case asBC_ADDi64: case asBC_SUBi64: case asBC_MULi64: case asBC_DIVi64: case asBC_MODi64: case asBC_DIVu64: case asBC_MODu64:
+				case asBC_ADDf: case asBC_SUBf: case asBC_MULf: case asBC_DIVf: case asBC_MODf:
+				case asBC_ADDd: case asBC_SUBd: case asBC_MULd: case asBC_DIVd: case asBC_MODd:
+				case asBC_ADDIi: case asBC_SUBIi: case asBC_MULIi: case asBC_ADDIf: case asBC_SUBIf: case asBC_MULIf:
+				case asBC_INCVi: case asBC_DECVi: case asBC_NEGi: case asBC_NEGi64: case asBC_NEGf: case asBC_NEGd: case asBC_BNOT: case asBC_BNOT64:
+				case asBC_BAND: case asBC_BOR: case asBC_BXOR: case asBC_BAND64: case asBC_BOR64: case asBC_BXOR64:
+				case asBC_BSLL: case asBC_BSRL: case asBC_BSRA: case asBC_BSLL64: case asBC_BSRL64: case asBC_BSRA64:
+					return true;
+				case asBC_iTOf: case asBC_fTOi: case asBC_uTOf: case asBC_sbTOi: case asBC_swTOi: case asBC_ubTOi: case asBC_uwTOi:
+				case asBC_dTOi: case asBC_dTOf: case asBC_iTOd: case asBC_uTOd: case asBC_fTOd:
+				case asBC_i64TOi: case asBC_uTOi64: case asBC_iTOi64: case asBC_fTOi64: case asBC_dTOi64: case asBC_i64TOf: case asBC_i64TOd:
+					return asBCInfo[op].type == asBCTYPE_rW_ARG || asBCInfo[op].type == asBCTYPE_wW_rW_ARG;
+				default:
+					return false;
+			}
+		}
+		static float to_float(asDWORD bits)
+		{
+			float result;
+			memcpy(&result, &bits, sizeof(result));
+			return result;
+		}
+	};
+
+	class aot_compiler final : public asIJITCompiler
+	{
+	private:
+		unordered_map<string, const aot_function*> functions;
+
+	public:
+		aot_compiler(const aot_function* items, size_t count)
+		{
+			functions.reserve(count);
+			for (size_t i = 0; i < count; i++)
+				functions[items[i].declaration] = &items[i];
+		}
+		int CompileFunction(asIScriptFunction* function, asJITFunction* output) override
+		{
+			auto it = functions.find(function->GetDeclaration(true, true, false));
+			if (it == functions.end())
+				return asNO_FUNCTION;
+
+			asUINT length = 0;
+			asDWORD* byte_code = function->GetByteCode(&length);
+			const aot_function* target = it->second;
+			if (!byte_code || length != target->length || aot_function::get_hash(byte_code, length) != target->hash)
+			{
+				VI_DEBUG("%s aot mismatch: bytecode differs from translated one", target->declaration);
+				return asNO_FUNCTION;
+			}
+
+			/* entry arguments select a resume point, zero keeps the instruction interpreted */
+			for (asUINT i = 0; i < target->entries_count; i++)
+				*(asPWORD*)(byte_code + target->entries[i] + 1) = (asPWORD)i + 1;
+
+			*output = target->callable;
+			return asSUCCESS;
+		}
+		void ReleaseJITFunction(asJITFunction) override
+		{
+		}
+	};
+
+	struct benchmark_target
+	{
+		string name;
+		size_t iterations = 1000;
+		size_t warmup = 100;
+	};
+
 	struct environment_config
 	{
 		inline_args commandline;
+		unordered_map<string, std::pair<string, string>> locked_addons;
 		unordered_set<string> addons;
+		unordered_set<string> includes;
+		vector<benchmark_target> benchmarks;
+		vector<string> pending_addons;
 		function_delegate at_exit;
+		startup_profiler profiler;
+		gc_policy gc;
+		gc_statistics gc_stats;
 		file_entry file;
 		string name;
 		string path;
@@ -46,14 +554,20 @@ namespace asx
 		string mode;
 		string output;
 		string addon;
+		string profile;
+		string bench_output;
+		string bench_baseline;
+		string pgo_training;
+		string mirror;
 		compiler* this_compiler;
 		const char* library;
+		uint32_t profile_frequency;
 		int32_t auto_schedule;
 		bool auto_console;
 		bool auto_stop;
 		bool inlined;
 
-		environment_config() : this_compiler(nullptr), library("__anonymous__"), auto_schedule(-1), auto_console(false), auto_stop(false), inlined(true)
+		environment_config() : this_compiler(nullptr), library("__anonymous__"), profile_frequency(99), auto_schedule(-1), auto_console(false), auto_stop(false), inlined(true)
 		{
 		}
 		void parse(int args_count, char** args_data, const unordered_set<string>& flags = { })
@@ -74,6 +588,7 @@ namespace asx
 		unordered_map<access_option, bool> permissions;
 		vector<std::pair<string, bool>> libraries;
 		vector<std::pair<string, int32_t>> settings;
+		vector<std::pair<string, string>> gc_settings;
 		vector<string> system_addons;
 		bool ts_imports = true;
 		bool tags = true;
@@ -83,17 +598,202 @@ namespace asx
 		bool load_byte_code = false;
 		bool save_byte_code = false;
 		bool save_source_code = false;
+		bool cache = true;
+		bool bench = false;
 		bool full_stack_tracing = true;
 		bool dependencies = false;
 		bool install = false;
+		bool lto = false;
+		bool pgo = false;
+		bool aot = false;
 		size_t installed = 0;
+		size_t workers = 0;
+		size_t jobs = 1;
+	};
+
+	class sampling_profiler
+	{
+	public:
+		static constexpr size_t max_frames = 48;
+		static constexpr size_t max_samples = 4096;
+
+		struct sample
+		{
+			std::atomic<bool> ready = { false };
+			int frames[max_frames];
+			uint32_t size = 0;
+		};
+
+		struct state
+		{
+			unordered_map<string, uint64_t> stacks;
+			sample samples[max_samples];
+			std::atomic<uint64_t> writes = { 0 };
+			std::atomic<uint64_t> dropped = { 0 };
+			std::atomic<bool> dump = { false };
+			asIScriptEngine* engine = nullptr;
+			uint64_t reads = 0;
+			string output;
+		};
+
+	public:
+		static bool start(const std::string_view& output, uint32_t frequency, virtual_machine* vm)
+		{
+#ifdef VI_UNIX
+			if (get() != nullptr || !frequency)
+				return false;
+
+			state* base = new state();
+			base->output = output;
+			base->engine = vm->get_engine();
+			get() = base;
+
+			struct sigaction action;
+			memset(&action, 0, sizeof(action));
+			action.sa_handler = &record;
+			action.sa_flags = SA_RESTART;
+			sigemptyset(&action.sa_mask);
+			sigaction(SIGPROF, &action, nullptr);
+			signal(SIGUSR2, [](int) { if (get() != nullptr) get()->dump = true; });
+
+			struct itimerval timer;
+			timer.it_interval.tv_sec = 0;
+			timer.it_interval.tv_usec = (suseconds_t)(1000000 / std::max<uint32_t>(1, std::min<uint32_t>(frequency, 10000)));
+			timer.it_value = timer.it_interval;
+			setitimer(ITIMER_PROF, &timer, nullptr);
+			return true;
+#else
+			VI_WARN("sampling profiler is not supported on this platform");
+			return false;
+#endif
+		}
+		static void stop()
+		{
+#ifdef VI_UNIX
+			state* base = get();
+			if (!base)
+				return;
+
+			struct itimerval timer;
+			memset(&timer, 0, sizeof(timer));
+			setitimer(ITIMER_PROF, &timer, nullptr);
+			signal(SIGPROF, SIG_IGN);
+			signal(SIGUSR2, SIG_DFL);
+			flush();
+			get() = nullptr;
+			delete base;
+#endif
+		}
+		static void update()
+		{
+			state* base = get();
+			if (!base)
+				return;
+
+			collect();
+			if (base->dump.exchange(false))
+				flush();
+		}
+
+	private:
+		static void record(int)
+		{
+			state* base = get();
+			if (!base)
+				return;
+
+			auto& item = base->samples[base->writes.fetch_add(1, std::memory_order_relaxed) % max_samples];
+			if (item.ready.load(std::memory_order_acquire))
+			{
+				base->dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			/* timer interrupts thread that consumed cpu time, its active context (if any) is read right here without any script hooks */
+			item.size = 0;
+			asIScriptContext* context = asGetActiveContext();
+			if (context != nullptr && context->GetState() == asEXECUTION_ACTIVE)
+			{
+				asUINT size = std::min<asUINT>(context->GetCallstackSize(), (asUINT)max_frames);
+				for (asUINT i = 0; i < size; i++)
+				{
+					asIScriptFunction* function = context->GetFunction(i);
+					if (function != nullptr)
+						item.frames[item.size++] = function->GetId();
+				}
+			}
+			item.ready.store(true, std::memory_order_release);
+		}
+		static void collect()
+		{
+			state* base = get();
+			uint64_t writes = base->writes.load(std::memory_order_acquire);
+			for (; base->reads < writes; base->reads++)
+			{
+				auto& item = base->samples[base->reads % max_samples];
+				if (!item.ready.load(std::memory_order_acquire))
+					continue;
+
+				string stack;
+				for (uint32_t i = item.size; i-- > 0;)
+				{
+					if (!stack.empty())
+						stack += ';';
+
+					asIScriptFunction* function = base->engine->GetFunctionById(item.frames[i]);
+					if (!function)
+					{
+						stack += "[unknown]";
+						continue;
+					}
+
+					function->AddRef();
+					const char* name_space = function->GetNamespace();
+					const char* type_name = function->GetObjectName();
+					if (name_space != nullptr && *name_space != '\0')
+						stack.append(name_space).append("::");
+					if (type_name != nullptr)
+						stack.append(type_name).append("::");
+					stack += function->GetName();
+					function->Release();
+				}
+
+				++base->stacks[stack.empty() ? string("[native]") : stack];
+				item.ready.store(false, std::memory_order_release);
+			}
+		}
+		static void flush()
+		{
+			state* base = get();
+			collect();
+
+			string data;
+			for (auto& item : base->stacks)
+				data += item.first + " " + to_string(item.second) + "\n";
+
+			if (!os::file::write(base->output, (uint8_t*)data.data(), data.size()))
+				VI_ERR("%s profile error: write failed", base->output.c_str());
+			else if (base->dropped > 0)
+				VI_WARN("%s profile warning: %" PRIu64 " samples dropped", base->output.c_str(), (uint64_t)base->dropped.load());
+		}
+		static state*& get()
+		{
+			static state* base = nullptr;
+			return base;
+		}
 	};
 
 	class runtime
 	{
+	public:
+		static constexpr size_t max_workers = 256;
+
 	public:
 		static void startup_environment(environment_config& env)
 		{
+			env.profiler.record("entrypoint");
+			env.profiler.finish();
+
 			if (env.auto_schedule >= 0)
 				schedule::get()->start(env.auto_schedule > 0 ? schedule::desc((size_t)env.auto_schedule) : schedule::desc());
 
@@ -152,10 +852,25 @@ namespace asx
 			environment_config::get(&env);
 
 			vm->import_system_addon("ctypes");
+			if (!shared_buffer::bind(vm))
+				return false;
+
 			vm->begin_namespace("this_process");
 			vm->set_function_def("void exit_event(int)");
 			vm->set_function("void before_exit(exit_event@)", &runtime::apply_context_exit);
 			vm->set_function("uptr@ get_compiler()", &runtime::get_compiler);
+			vm->set_function("bool is_worker()", &runtime::get_worker);
+			vm->set_function("bool share_socket(usize)", &runtime::share_socket);
+			vm->end_namespace();
+			vm->begin_namespace("this_process::gc");
+			vm->set_function("uint64 get_collections()", &runtime::get_gc_collections);
+			vm->set_function("uint64 get_pause_time()", &runtime::get_gc_pause_time);
+			vm->set_function("uint64 get_max_pause_time()", &runtime::get_gc_max_pause_time);
+			vm->set_function("uint64 get_scanned_objects()", &runtime::get_gc_scanned_objects);
+			vm->set_function("uint64 get_freed_objects()", &runtime::get_gc_freed_objects);
+			vm->set_function("uint64 get_detected_cycles()", &runtime::get_gc_detected_cycles);
+			vm->set_function("uint64 get_live_objects()", &runtime::get_gc_live_objects);
+			vm->set_function("uint64 get_new_objects()", &runtime::get_gc_new_objects);
 			vm->end_namespace();
 			return true;
 		}
@@ -180,13 +895,30 @@ namespace asx
 		}
 		static void await_context(std::mutex& mutex, event_loop* loop, virtual_machine* vm, immediate_context* context)
 		{
+			auto& env = environment_config::get();
+			auto& gc = env.gc;
+			auto time = std::chrono::steady_clock::now();
+			uint64_t timeout = 1000;
+			if (!env.profile.empty())
+				sampling_profiler::start(env.profile, env.profile_frequency, vm);
+
+			auto& completions = native_completions::get();
+			completions.listen(loop);
 			event_loop::set(loop);
-			while (loop->poll_extended(context, 1000))
+#ifdef VI_UNIX
+			set_worker_ready();
+#endif
+			while (loop->poll_extended(context, timeout) || completions.wait(timeout))
 			{
-				vm->perform_periodic_garbage_collection(60000);
+				bool idle = std::chrono::steady_clock::now() - time >= std::chrono::milliseconds(timeout);
+				completions.dispatch();
 				loop->dequeue(vm);
+				timeout = collect_garbage(gc, env.gc_stats, vm, idle) ? 1 : 1000;
+				time = std::chrono::steady_clock::now();
+				sampling_profiler::update();
 			}
 
+			completions.reject();
 			umutex<std::mutex> unique(mutex);
 			if (schedule::has_instance())
 			{
@@ -196,9 +928,15 @@ namespace asx
 				schedule::cleanup_instance();
 			}
 
+			sampling_profiler::stop();
+			completions.listen(nullptr);
 			event_loop::set(nullptr);
 			context->reset();
+			env.gc_stats.begin(vm->get_engine());
 			vm->perform_full_garbage_collection();
+			env.gc_stats.end(vm->get_engine(), true);
+			if (env.gc_stats.report)
+				env.gc_stats.print(vm->get_engine());
 			apply_context_exit(nullptr);
 		}
 		static void context_thrown(immediate_context* context)
@@ -230,13 +968,315 @@ namespace asx
 		{
 			return environment_config::get().this_compiler;
 		}
+		static bool get_worker()
+		{
+			return is_worker();
+		}
+		static uint64_t get_gc_collections()
+		{
+			return environment_config::get().gc_stats.collections;
+		}
+		static uint64_t get_gc_pause_time()
+		{
+			return environment_config::get().gc_stats.nanoseconds;
+		}
+		static uint64_t get_gc_max_pause_time()
+		{
+			return environment_config::get().gc_stats.max_nanoseconds;
+		}
+		static uint64_t get_gc_scanned_objects()
+		{
+			return environment_config::get().gc_stats.scanned;
+		}
+		static uint64_t get_gc_freed_objects()
+		{
+			return environment_config::get().gc_stats.freed;
+		}
+		static uint64_t get_gc_detected_cycles()
+		{
+			return environment_config::get().gc_stats.detected;
+		}
+		static uint64_t get_gc_live_objects()
+		{
+			asUINT size = 0;
+			environment_config::get().this_compiler->get_vm()->get_engine()->GetGCStatistics(&size);
+			return (uint64_t)size;
+		}
+		static uint64_t get_gc_new_objects()
+		{
+			asUINT new_objects = 0;
+			environment_config::get().this_compiler->get_vm()->get_engine()->GetGCStatistics(nullptr, nullptr, nullptr, &new_objects);
+			return (uint64_t)new_objects;
+		}
+		static bool spawn_workers(size_t count, int& exit_code)
+		{
+#ifdef VI_UNIX
+			if (count < 2)
+				return false;
+
+			if (count > max_workers)
+			{
+				VI_WARN("cluster warning: workers count is limited to %i", (int)max_workers);
+				count = max_workers;
+			}
+
+			auto* workers = get_workers();
+			auto* ready = get_ready(true);
+			vector<std::chrono::steady_clock::time_point> starts(count);
+			for (size_t i = 0; i < max_workers; i++)
+				workers[i] = 0;
+			get_workers_count() = (sig_atomic_t)count;
+			signal(SIGCHLD, SIG_DFL);
+			signal(SIGINT, &forward_signal);
+			signal(SIGTERM, &forward_signal);
+
+			size_t alive = 0;
+			for (size_t i = 0; i < count; i++)
+			{
+				pid_t pid = fork();
+				if (pid == 0)
+					return enter_worker(i);
+				else if (pid < 0)
+				{
+					VI_ERR("cluster error: cannot fork worker %i", (int)i);
+					continue;
+				}
+
+				VI_DEBUG("cluster worker %i started [pid %i]", (int)i, (int)pid);
+				starts[i] = std::chrono::steady_clock::now();
+				workers[i] = pid;
+				++alive;
+			}
+
+			exit_code = 0;
+			while (alive > 0)
+			{
+				int status = 0;
+				pid_t pid = waitpid(-1, &status, 0);
+				if (pid < 0)
+				{
+					if (errno == EINTR)
+						continue;
+					break;
+				}
+
+				auto* it = std::find(workers, workers + count, pid);
+				if (it == workers + count)
+					continue;
+
+				size_t index = it - workers;
+				bool crashed = WIFSIGNALED(status) || (WIFEXITED(status) && WEXITSTATUS(status) != 0);
+				bool started = !ready || ready[index] != 0;
+				*it = 0;
+				--alive;
+				if (!crashed || get_signal() != 0)
+				{
+					if (crashed && !exit_code)
+						exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : (int)exit_status::kill;
+					continue;
+				}
+
+				/* worker that never reached its event loop would fail the same way again (e.g. listener could not be bound) */
+				if (!started)
+				{
+					VI_ERR("cluster worker %i failed during startup [pid %i]: not restarting", (int)index, (int)pid);
+					if (!exit_code)
+						exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : (int)exit_status::kill;
+					continue;
+				}
+
+				VI_WARN("cluster worker %i crashed [pid %i]: restarting", (int)index, (int)pid);
+				if (std::chrono::steady_clock::now() - starts[index] < std::chrono::seconds(1))
+					std::this_thread::sleep_for(std::chrono::seconds(1));
+
+				/* shutdown signal may arrive during the pause, it is blocked until new pid is visible to forward_signal */
+				sigset_t mask, previous;
+				sigemptyset(&mask);
+				sigaddset(&mask, SIGINT);
+				sigaddset(&mask, SIGTERM);
+				sigprocmask(SIG_BLOCK, &mask, &previous);
+				if (get_signal() != 0)
+				{
+					sigprocmask(SIG_SETMASK, &previous, nullptr);
+					continue;
+				}
+
+				if (ready != nullptr)
+					ready[index] = 0;
+				pid = fork();
+				if (pid == 0)
+				{
+					bool result = enter_worker(index);
+					sigprocmask(SIG_SETMASK, &previous, nullptr);
+					return result;
+				}
+				else if (pid > 0)
+				{
+					starts[index] = std::chrono::steady_clock::now();
+					*it = pid;
+					++alive;
+				}
+				else
+					VI_ERR("cluster error: cannot fork worker %i", (int)index);
+				sigprocmask(SIG_SETMASK, &previous, nullptr);
+			}
+			return true;
+#else
+			if (count > 1)
+				VI_WARN("cluster mode is not supported on this platform: running single instance");
+			return false;
+#endif
+		}
+		static bool& is_worker()
+		{
+			static bool worker = false;
+			return worker;
+		}
+		static bool share_socket(size_t fd)
+		{
+#if defined(VI_UNIX) && defined(SO_REUSEPORT)
+			if (!is_worker())
+				return true;
+
+			int value = 1;
+			return setsockopt((int)fd, SOL_SOCKET, SO_REUSEPORT, &value, sizeof(value)) == 0;
+#else
+			return !is_worker();
+#endif
+		}
 
 	private:
+		static bool collect_garbage(gc_policy& policy, gc_statistics& stats, virtual_machine* vm, bool idle)
+		{
+			asUINT size = 0;
+			auto* engine = vm->get_engine();
+			if (!policy.adaptive)
+			{
+				auto time = std::chrono::steady_clock::now();
+				if (time - policy.collected < std::chrono::milliseconds(policy.interval))
+					return false;
+
+				stats.begin(engine);
+				vm->perform_full_garbage_collection();
+				stats.end(engine, true);
+				policy.collected = time;
+				return false;
+			}
+
+			engine->GetGCStatistics(&size);
+			if (size < policy.baseline)
+				policy.baseline = size;
+
+			auto time = std::chrono::steady_clock::now();
+			bool growing = size >= policy.baseline + policy.growth;
+			bool expired = size > policy.baseline && time - policy.collected >= std::chrono::milliseconds(policy.interval);
+			bool available = idle && (policy.pending || size > policy.baseline);
+			if (!growing && !expired && !available)
+				return false;
+
+			auto deadline = time + std::chrono::microseconds(policy.pause);
+			stats.begin(engine);
+			do
+			{
+				if (engine->GarbageCollect(asGC_ONE_STEP | asGC_DETECT_GARBAGE | asGC_DESTROY_GARBAGE, 1) == 0)
+				{
+					stats.end(engine, true);
+					engine->GetGCStatistics(&size);
+					policy.collected = std::chrono::steady_clock::now();
+					policy.baseline = size;
+					policy.pending = false;
+					return false;
+				}
+			} while (std::chrono::steady_clock::now() < deadline);
+			stats.end(engine, false);
+			policy.pending = true;
+			return true;
+		}
+#ifdef VI_UNIX
+		static bool enter_worker(size_t index)
+		{
+			signal(SIGINT, SIG_DFL);
+			signal(SIGTERM, SIG_DFL);
+			setenv("ASX_WORKER", std::to_string(index).c_str(), 1);
+			get_workers_count() = 0;
+			get_worker_index() = index;
+			is_worker() = true;
+			return false;
+		}
+		static void set_worker_ready()
+		{
+			auto* ready = is_worker() ? get_ready(false) : nullptr;
+			if (ready != nullptr)
+				ready[get_worker_index()] = 1;
+		}
+		static void forward_signal(int value)
+		{
+			auto* workers = get_workers();
+			sig_atomic_t count = get_workers_count();
+			get_signal() = value;
+			for (sig_atomic_t i = 0; i < count; i++)
+			{
+				pid_t pid = workers[i];
+				if (pid > 0)
+					kill(pid, value);
+			}
+		}
+		static volatile pid_t* get_workers()
+		{
+			static volatile pid_t workers[max_workers];
+			return workers;
+		}
+		static volatile sig_atomic_t& get_workers_count()
+		{
+			static volatile sig_atomic_t count = 0;
+			return count;
+		}
+		static volatile sig_atomic_t& get_signal()
+		{
+			static volatile sig_atomic_t value = 0;
+			return value;
+		}
+		static volatile sig_atomic_t* get_ready(bool create)
+		{
+			/* shared with forked workers, each one marks its own slot once it reaches the event loop */
+			static volatile sig_atomic_t* ready = nullptr;
+			if (!ready && create)
+			{
+				void* data = mmap(nullptr, sizeof(sig_atomic_t) * max_workers, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+				ready = data != MAP_FAILED ? (volatile sig_atomic_t*)data : nullptr;
+			}
+			return ready;
+		}
+		static size_t& get_worker_index()
+		{
+			static size_t index = 0;
+			return index;
+		}
+#endif
 		static void process_tags(virtual_machine* vm, bindings::tags::tag_info&& info)
 		{
 			auto& env = environment_config::get();
 			for (auto& tag : info)
 			{
+				for (auto& directive : tag.directives)
+				{
+					if (directive.name != "#bench")
+						continue;
+
+					benchmark_target target;
+					target.name = tag.name;
+
+					auto iterations = directive.args.find("iterations");
+					if (iterations != directive.args.end())
+						target.iterations = from_string<uint64_t>(iterations->second).or_else(target.iterations);
+
+					auto warmup = directive.args.find("warmup");
+					if (warmup != directive.args.end())
+						target.warmup = from_string<uint64_t>(warmup->second).or_else(target.warmup);
+
+					env.benchmarks.push_back(std::move(target));
+				}
+
 				if (tag.name != "main")
 					continue;
 
@@ -263,6 +1303,14 @@ namespace asx
 					}
 					else if (directive.name == "#console::main")
 						env.auto_console = true;
+					else if (directive.name == "#gc::main")
+					{
+						for (auto& arg : directive.args)
+						{
+							if (!env.gc.configure(arg.first, arg.second))
+								VI_WARN("#gc::main tag warning: invalid argument %s = %s", arg.first.c_str(), arg.second.c_str());
+						}
+					}
 				}
 			}
 		}